@@ -0,0 +1,213 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+/*
+    A benchmark for the geometry of rounded boxes, as being created
+    by QskBoxRenderer for QskBoxNode:
+
+        - border: the border lines only ( monochrome )
+        - fill: the fill lines only ( monochrome )
+        - box: border and fill lines with colors in one pass
+
+    The boxes have regular or irregular radii - what results in
+    different code paths - and the number of steps for each corner
+    increases with the radius.
+
+    The corner offsets are calculated with SIMD instructions, when
+    available. For a baseline the benchmark runs itself a second time
+    with QSK_NO_SIMD being set, what forces the scalar implementation.
+
+    The results are written as CSV to stdout, including the number of
+    vertices of each measurement and the throughput in vertices per µs,
+    calculated from the median.
+ */
+
+#include "Benchmark.h"
+
+#include <QskBoxBorderColors.h>
+#include <QskBoxBorderMetrics.h>
+#include <QskBoxRenderer.h>
+#include <QskBoxShapeMetrics.h>
+#include <QskGradient.h>
+
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QProcess>
+#include <QSGGeometry>
+#include <QTextStream>
+
+namespace
+{
+    enum Operation
+    {
+        Border,
+        Fill,
+        Box
+    };
+}
+
+static Samples qskMeasure( Operation operation, int boxCount, int iterations,
+    const QRectF& rect, const QskBoxShapeMetrics& shape, qint64& vertexCount )
+{
+    const QskBoxBorderMetrics borderMetrics( 2 );
+    const QskBoxBorderColors borderColors( Qt::darkBlue );
+    const QskGradient gradient( QskGradient::Vertical, Qt::white, Qt::lightGray );
+
+    QSGGeometry pointGeometry( QSGGeometry::defaultAttributes_Point2D(), 0 );
+    QSGGeometry colorGeometry( QSGGeometry::defaultAttributes_ColoredPoint2D(), 0 );
+
+    QskBoxRenderer renderer;
+    Samples samples;
+
+    vertexCount = 0;
+
+    for ( int i = 0; i < iterations; i++ )
+    {
+        qint64 count = 0;
+
+        QElapsedTimer timer;
+        timer.start();
+
+        for ( int j = 0; j < boxCount; j++ )
+        {
+            // slightly different boxes, like during an animation
+            const auto r = rect.adjusted( 0, 0, j % 8, j % 8 );
+
+            switch( operation )
+            {
+                case Border:
+                    renderer.renderBorder( r, shape, borderMetrics, pointGeometry );
+                    count += pointGeometry.vertexCount();
+                    break;
+
+                case Fill:
+                    renderer.renderFill( r, shape, borderMetrics, pointGeometry );
+                    count += pointGeometry.vertexCount();
+                    break;
+
+                case Box:
+                    renderer.renderBox( r, shape, borderMetrics,
+                        borderColors, gradient, colorGeometry );
+                    count += colorGeometry.vertexCount();
+                    break;
+            }
+        }
+
+        samples.add( timer.nsecsElapsed() );
+
+        vertexCount = count;
+    }
+
+    return samples;
+}
+
+static QString qskThroughput( qint64 vertexCount, qint64 ns )
+{
+    if ( ns <= 0 )
+        return QString();
+
+    return QString::number( 1000.0 * vertexCount / ns, 'f', 1 );
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+    QGuiApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Benchmarking the geometry of rounded boxes" );
+    parser.addHelpOption();
+
+    parser.addOptions( {
+        { "boxes", "Number of boxes for each measurement", "count", "1000" },
+        { "iterations", "Number of measurements", "count", "50" },
+        { "no-baseline", "Don't run the scalar implementation" },
+        { "header", "Write the CSV header" }
+    } );
+
+    parser.process( app );
+
+    const int boxCount = qMax( parser.value( "boxes" ).toInt(), 1 );
+    const int iterations = qMax( parser.value( "iterations" ).toInt(), 1 );
+
+    const bool isScalar = qEnvironmentVariableIsSet( "QSK_NO_SIMD" );
+
+    QTextStream out( stdout );
+
+    if ( parser.isSet( "header" ) )
+    {
+        out << "implementation,operation,radii,radius,boxes,vertices,"
+            "iterations,min_ns,median_ns,mean_ns,vertices_per_us\n";
+    }
+
+    const char* operations[] = { "border", "fill", "box" };
+
+    for ( const qreal radius : { 4.0, 16.0, 64.0 } )
+    {
+        const QRectF rect( 0.0, 0.0, 4 * radius + 100, 4 * radius + 50 );
+
+        const QskBoxShapeMetrics regularShape( radius );
+
+        const QskBoxShapeMetrics irregularShape(
+            radius, 0.5 * radius, 0.75 * radius, 0.25 * radius );
+
+        for ( int operation = Border; operation <= Box; operation++ )
+        {
+            const struct
+            {
+                const char* name;
+                const QskBoxShapeMetrics& shape;
+            } radii[] =
+            {
+                { "regular", regularShape },
+                { "irregular", irregularShape }
+            };
+
+            for ( const auto& r : radii )
+            {
+                qint64 vertexCount;
+
+                const auto samples = qskMeasure( static_cast< Operation >( operation ),
+                    boxCount, iterations, rect, r.shape, vertexCount );
+
+                out << ( isScalar ? "scalar" : "simd" ) << ','
+                    << operations[ operation ] << ',' << r.name << ','
+                    << radius << ',' << boxCount << ',' << vertexCount << ','
+                    << samples.toCsv() << ','
+                    << qskThroughput( vertexCount, samples.median() ) << '\n';
+            }
+        }
+    }
+
+    out.flush();
+
+    if ( isScalar || parser.isSet( "no-baseline" ) )
+        return 0;
+
+    // the baseline: the same measurements with the scalar implementation
+
+    auto arguments = app.arguments().mid( 1 );
+    arguments.removeAll( QStringLiteral( "--header" ) );
+
+    auto environment = QProcessEnvironment::systemEnvironment();
+    environment.insert( QStringLiteral( "QSK_NO_SIMD" ), QStringLiteral( "1" ) );
+
+    QProcess process;
+    process.setProcessEnvironment( environment );
+    process.setProcessChannelMode( QProcess::ForwardedChannels );
+
+    process.start( app.applicationFilePath(), arguments );
+
+    if ( !process.waitForFinished( -1 ) || process.exitCode() != 0 )
+    {
+        qWarning( "Running the scalar baseline failed" );
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+/*
+    The durations of the measurements of a benchmark. The statistics
+    are written as CSV columns: count,min_ns,median_ns,mean_ns
+ */
+
+#include <QString>
+#include <QVector>
+
+#include <algorithm>
+
+class Samples
+{
+  public:
+    void add( qint64 ns ) { m_values += ns; }
+
+    int count() const { return m_values.count(); }
+
+    qint64 min() const
+    {
+        return m_values.isEmpty() ? 0
+            : *std::min_element( m_values.cbegin(), m_values.cend() );
+    }
+
+    qint64 median() const
+    {
+        if ( m_values.isEmpty() )
+            return 0;
+
+        auto values = m_values;
+        std::sort( values.begin(), values.end() );
+
+        return values[ values.count() / 2 ];
+    }
+
+    qint64 mean() const
+    {
+        if ( m_values.isEmpty() )
+            return 0;
+
+        qint64 sum = 0;
+        for ( auto value : m_values )
+            sum += value;
+
+        return sum / m_values.count();
+    }
+
+    QString toCsv() const
+    {
+        return QStringLiteral( "%1,%2,%3,%4" )
+            .arg( count() ).arg( min() ).arg( median() ).arg( mean() );
+    }
+
+  private:
+    QVector< qint64 > m_values;
+};
+
+#endif
@@ -0,0 +1,154 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+/*
+    A benchmark for generating M3 color schemes from key colors, like
+    it is done by QskMaterial3Theme, when switching the accent color:
+
+        - rgb: calculating each color by QskHctColor::toned().rgb()
+
+        - palette: calculating the tonal palettes by QskTonalPalette
+          and looking up the colors
+
+        - cachedPalette: the same, but with palettes from the cache
+
+    Each iteration creates a light and a dark scheme from 6 key colors.
+    The hue of the key colors is rotated, to simulate different accent colors.
+
+    The results are written as CSV to stdout.
+ */
+
+#include "Benchmark.h"
+
+#include <QskHctColor.h>
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTextStream>
+
+namespace
+{
+    const QRgb keyColors[] =
+    {
+        0xff6750A4, 0xff625B71, 0xff7D5260,
+        0xffB3261E, 0xff605D62, 0xff605D66
+    };
+
+    const int keyColorCount = sizeof( keyColors ) / sizeof( keyColors[0] );
+
+    // tones of the key colors used by the light and the dark scheme
+    const qreal schemeTones[][8] =
+    {
+        { 40, 100, 90, 10, 80, 20, 30, 90 },
+        { 40, 100, 90, 10, 80, 20, 30, 90 },
+        { 40, 100, 90, 10, 80, 20, 30, 90 },
+        { 40, 100, 90, 10, 80, 20, 30, 90 },
+        { 99, 10, 0, 90, 80, 10, 99, 0 },
+        { 90, 30, 50, 80, 60, 30, 90, 50 }
+    };
+}
+
+static QskHctColor qskKeyColor( int index, int iteration )
+{
+    QskHctColor color( keyColors[ index ] );
+    color.setHue( color.hue() + 7 * iteration );
+
+    return color;
+}
+
+static QRgb qskSchemeRgb( int iteration )
+{
+    QRgb rgb = 0;
+
+    for ( int i = 0; i < keyColorCount; i++ )
+    {
+        const auto color = qskKeyColor( i, iteration );
+
+        for ( const auto tone : schemeTones[ i ] )
+            rgb ^= color.toned( tone ).rgb();
+    }
+
+    return rgb;
+}
+
+static QRgb qskSchemePalette( int iteration )
+{
+    QRgb rgb = 0;
+
+    for ( int i = 0; i < keyColorCount; i++ )
+    {
+        const QskTonalPalette palette( qskKeyColor( i, iteration ) );
+
+        for ( const auto tone : schemeTones[ i ] )
+            rgb ^= palette.rgb( tone );
+    }
+
+    return rgb;
+}
+
+int main( int argc, char* argv[] )
+{
+    QCoreApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Benchmarking the generation of M3 color schemes" );
+    parser.addHelpOption();
+
+    parser.addOptions( {
+        { "iterations", "Number of measurements", "count", "100" },
+        { "header", "Write the CSV header" }
+    } );
+
+    parser.process( app );
+
+    const int iterations = qMax( parser.value( "iterations" ).toInt(), 1 );
+
+    QTextStream out( stdout );
+
+    if ( parser.isSet( "header" ) )
+        out << "operation,colors,iterations,min_ns,median_ns,mean_ns\n";
+
+    const int colorCount = keyColorCount * 8;
+
+    Samples rgbSamples, paletteSamples, cachedSamples;
+
+    QRgb check = 0;
+
+    for ( int i = 0; i < iterations; i++ )
+    {
+        QElapsedTimer timer;
+
+        timer.start();
+        const auto rgb1 = qskSchemeRgb( i );
+        rgbSamples.add( timer.nsecsElapsed() );
+
+        QskTonalPalette::clearCache();
+
+        timer.start();
+        const auto rgb2 = qskSchemePalette( i );
+        paletteSamples.add( timer.nsecsElapsed() );
+
+        timer.start();
+        const auto rgb3 = qskSchemePalette( i );
+        cachedSamples.add( timer.nsecsElapsed() );
+
+        if ( rgb1 != rgb2 || rgb2 != rgb3 )
+            check++;
+    }
+
+    out << "rgb," << colorCount << ',' << rgbSamples.toCsv() << '\n';
+    out << "palette," << colorCount << ',' << paletteSamples.toCsv() << '\n';
+    out << "cachedPalette," << colorCount << ',' << cachedSamples.toCsv() << '\n';
+    out.flush();
+
+    if ( check )
+    {
+        qWarning( "%d iterations with different results", int( check ) );
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,10 @@
+CONFIG += qskexample
+CONFIG -= app_bundle
+
+INCLUDEPATH += $$PWD/../common
+
+HEADERS += \
+    ../common/Benchmark.h
+
+SOURCES += \
+    main.cpp
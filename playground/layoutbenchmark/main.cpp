@@ -0,0 +1,487 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+/*
+    A headless benchmark for the layout code. It builds trees of
+    QskGridBox, QskLinearBox or QskStackBox and measures the latencies of:
+
+        - sizeHint: calculating the size hint after all boxes
+          have been invalidated
+
+        - setGeometries: laying out the tree after resizing the root box.
+          The sizes alternate between below and above the preferred size,
+          so that both ways of distributing the space in QskLayoutChain
+          are involved.
+
+        - relayout: polishing after the preferred size of a single
+          leaf has changed
+
+    Then a box with many text labels is polished after all texts
+    have been changed - with QskWindow::parallelPolish disabled
+    ( polish ) and enabled ( parallelPolish ). As the texts are new for
+    each measurement, the caches of the text renderers don't help.
+    The geometries of the labels have to be the same for both modes,
+    otherwise the benchmark fails.
+
+    The results are written as CSV to stdout, so that they can be
+    collected and compared over time.
+ */
+
+#include "Benchmark.h"
+
+#include <QskGridBox.h>
+#include <QskLinearBox.h>
+#include <QskSizePolicy.h>
+#include <QskStackBox.h>
+#include <QskTextLabel.h>
+#include <QskWindow.h>
+
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QTextStream>
+#include <QtMath>
+#include <QVector>
+
+#include <cmath>
+
+namespace
+{
+    enum BoxType
+    {
+        Grid,
+        Linear,
+        Stack
+    };
+
+    class Options
+    {
+      public:
+        BoxType boxType = Linear;
+
+        int depth = 3;
+        int fanOut = 10;
+        int iterations = 50;
+
+        bool heightForWidth = false;
+        bool spans = false;
+    };
+
+    class Leaf : public QskControl
+    {
+      public:
+        Leaf( bool heightForWidth, QQuickItem* parent = nullptr )
+            : QskControl( parent )
+            , m_heightForWidth( heightForWidth )
+        {
+            if ( heightForWidth )
+                initSizePolicy( QskSizePolicy::Preferred, QskSizePolicy::Constrained );
+            else
+                initSizePolicy( QskSizePolicy::Preferred, QskSizePolicy::Preferred );
+
+            setMinimumSize( 10, 10 );
+        }
+
+        void toggleSize()
+        {
+            m_toggled = !m_toggled;
+            resetImplicitSize();
+        }
+
+      protected:
+        QSizeF contentsSizeHint(
+            Qt::SizeHint which, const QSizeF& constraint ) const override
+        {
+            if ( which != Qt::PreferredSize )
+                return QSizeF();
+
+            const qreal w = m_toggled ? 120 : 100;
+            const qreal h = 50;
+
+            if ( m_heightForWidth )
+            {
+                // keeping the area
+                if ( constraint.width() >= 0.0 )
+                    return QSizeF( -1.0, w * h / qMax( constraint.width(), 1.0 ) );
+
+                if ( constraint.height() >= 0.0 )
+                    return QSizeF( w * h / qMax( constraint.height(), 1.0 ), -1.0 );
+            }
+
+            return QSizeF( w, h );
+        }
+
+      private:
+        const bool m_heightForWidth;
+        bool m_toggled = false;
+    };
+
+    class Tree
+    {
+      public:
+        Tree( const Options& options )
+            : m_options( options )
+        {
+            root = createItem( options.depth, nullptr );
+        }
+
+        int itemCount() const
+        {
+            return boxes.count() + leafs.count();
+        }
+
+        QQuickItem* root = nullptr;
+
+        QVector< QskControl* > boxes;
+        QVector< Leaf* > leafs;
+
+      private:
+        QQuickItem* createItem( int depth, QQuickItem* parent )
+        {
+            if ( depth <= 0 )
+            {
+                auto leaf = new Leaf( m_options.heightForWidth, parent );
+                leafs += leaf;
+
+                return leaf;
+            }
+
+            const auto fanOut = m_options.fanOut;
+
+            switch( m_options.boxType )
+            {
+                case Grid:
+                {
+                    auto box = new QskGridBox( parent );
+
+                    const int columns = qCeil( std::sqrt( qreal( fanOut ) ) );
+
+                    int pos = 0;
+                    for ( int i = 0; i < fanOut; i++ )
+                    {
+                        const int columnSpan = ( m_options.spans && ( i % 3 == 0 ) ) ? 2 : 1;
+
+                        box->addItem( createItem( depth - 1, box ),
+                            pos / columns, pos % columns, 1, columnSpan );
+
+                        pos += columnSpan;
+                    }
+
+                    boxes += box;
+                    return box;
+                }
+                case Stack:
+                {
+                    auto box = new QskStackBox( parent );
+
+                    for ( int i = 0; i < fanOut; i++ )
+                        box->addItem( createItem( depth - 1, box ) );
+
+                    box->setCurrentIndex( 0 );
+
+                    boxes += box;
+                    return box;
+                }
+                default:
+                {
+                    const auto orientation =
+                        ( depth % 2 ) ? Qt::Vertical : Qt::Horizontal;
+
+                    auto box = new QskLinearBox( orientation, parent );
+
+                    for ( int i = 0; i < fanOut; i++ )
+                        box->addItem( createItem( depth - 1, box ) );
+
+                    boxes += box;
+                    return box;
+                }
+            }
+        }
+
+        const Options m_options;
+    };
+}
+
+static void qskInvalidateBoxes( const Tree& tree )
+{
+    // bottom up, as the children have been created first
+    for ( auto box : tree.boxes )
+    {
+        QEvent event( QEvent::LayoutRequest );
+        QCoreApplication::sendEvent( box, &event );
+    }
+}
+
+static Samples qskMeasureSizeHint( const Tree& tree, const Options& options )
+{
+    auto root = static_cast< QskControl* >( tree.root );
+
+    Samples samples;
+
+    for ( int i = 0; i < options.iterations; i++ )
+    {
+        qskInvalidateBoxes( tree );
+
+        QElapsedTimer timer;
+        timer.start();
+
+        if ( options.heightForWidth )
+            root->heightForWidth( 1000 );
+        else
+            root->effectiveSizeHint( Qt::PreferredSize );
+
+        samples.add( timer.nsecsElapsed() );
+    }
+
+    return samples;
+}
+
+static Samples qskMeasureGeometries(
+    QskWindow& window, const Tree& tree, const Options& options )
+{
+    auto root = static_cast< QskControl* >( tree.root );
+
+    const auto hint = root->effectiveSizeHint( Qt::PreferredSize );
+
+    Samples samples;
+
+    for ( int i = 0; i < options.iterations; i++ )
+    {
+        const qreal f = ( i % 2 ) ? 1.2 : 0.8;
+        root->setSize( QSizeF( f * hint.width(), f * hint.height() ) );
+
+        QElapsedTimer timer;
+        timer.start();
+
+        window.polishItems();
+
+        samples.add( timer.nsecsElapsed() );
+    }
+
+    return samples;
+}
+
+static Samples qskMeasureRelayout(
+    QskWindow& window, const Tree& tree, const Options& options )
+{
+    auto leaf = tree.leafs[ tree.leafs.count() / 2 ];
+
+    window.polishItems();
+
+    Samples samples;
+
+    for ( int i = 0; i < options.iterations; i++ )
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        leaf->toggleSize();
+        window.polishItems();
+
+        samples.add( timer.nsecsElapsed() );
+    }
+
+    return samples;
+}
+
+static void qskSetTexts( const QVector< QskTextLabel* >& labels )
+{
+    // texts, that have never been measured before
+    static int generation = 0;
+    generation++;
+
+    for ( int i = 0; i < labels.count(); i++ )
+        labels[ i ]->setText( QStringLiteral( "Label %1 - %2" ).arg( i ).arg( generation ) );
+}
+
+static Samples qskMeasureLabels( QskWindow& window,
+    const QVector< QskTextLabel* >& labels, const Options& options )
+{
+    window.polishItems();
+
+    Samples samples;
+
+    for ( int i = 0; i < options.iterations; i++ )
+    {
+        qskSetTexts( labels );
+
+        QElapsedTimer timer;
+        timer.start();
+
+        window.polishItems();
+
+        samples.add( timer.nsecsElapsed() );
+    }
+
+    return samples;
+}
+
+static QVector< QRectF > qskGeometries( QskWindow& window,
+    const QVector< QskTextLabel* >& labels, bool parallel )
+{
+    /*
+        To have both modes measuring the same texts, the texts
+        of the previous run need to be dropped from the caches first.
+        So we polish enough other texts before.
+     */
+    for ( int n = 0; n < 20000; n += labels.count() )
+    {
+        qskSetTexts( labels );
+        window.polishItems();
+    }
+
+    // same texts for both runs
+    for ( int i = 0; i < labels.count(); i++ )
+        labels[ i ]->setText( QStringLiteral( "Label %1" ).arg( i ) );
+
+    window.setParallelPolish( parallel );
+    window.polishItems();
+
+    QVector< QRectF > geometries;
+    geometries.reserve( labels.count() );
+
+    for ( const auto label : labels )
+        geometries += label->geometry();
+
+    return geometries;
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+    QGuiApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Benchmarking the QSkinny layout code" );
+    parser.addHelpOption();
+
+    parser.addOptions( {
+        { "box", "grid, linear, stack or all", "type", "all" },
+        { "depth", "Depth of the tree", "depth", "3" },
+        { "fanout", "Number of children of each box", "count", "10" },
+        { "iterations", "Number of measurements", "count", "50" },
+        { "hfw", "Leafs with a height-for-width constraint" },
+        { "spans", "Grid cells spanning 2 columns" },
+        { "labels", "Number of labels, 0 to skip the text benchmark", "count", "10000" },
+        { "header", "Write the CSV header" }
+    } );
+
+    parser.process( app );
+
+    Options options;
+    options.depth = qMax( parser.value( "depth" ).toInt(), 1 );
+    options.fanOut = qMax( parser.value( "fanout" ).toInt(), 1 );
+    options.iterations = qMax( parser.value( "iterations" ).toInt(), 1 );
+    options.heightForWidth = parser.isSet( "hfw" );
+    options.spans = parser.isSet( "spans" );
+
+    const auto boxName = parser.value( "box" );
+
+    QVector< BoxType > boxTypes;
+
+    if ( boxName == "grid" || boxName == "all" )
+        boxTypes += Grid;
+
+    if ( boxName == "linear" || boxName == "all" )
+        boxTypes += Linear;
+
+    if ( boxName == "stack" || boxName == "all" )
+        boxTypes += Stack;
+
+    QTextStream out( stdout );
+
+    if ( parser.isSet( "header" ) )
+    {
+        out << "box,depth,fanout,constraint,spans,items,"
+            "operation,iterations,min_ns,median_ns,mean_ns\n";
+    }
+
+    const char* names[] = { "grid", "linear", "stack" };
+
+    for ( const auto boxType : boxTypes )
+    {
+        options.boxType = boxType;
+
+        QskWindow window;
+        window.setAutoLayoutChildren( false );
+
+        Tree tree( options );
+        window.addItem( tree.root );
+
+        const auto prefix = QStringLiteral( "%1,%2,%3,%4,%5,%6," )
+            .arg( names[ boxType ] ).arg( options.depth ).arg( options.fanOut )
+            .arg( options.heightForWidth ? "hfw" : "none" )
+            .arg( options.spans ? 1 : 0 ).arg( tree.itemCount() );
+
+        const auto sizeHint = qskMeasureSizeHint( tree, options );
+        out << prefix << "sizeHint," << sizeHint.toCsv() << '\n';
+
+        const auto geometries = qskMeasureGeometries( window, tree, options );
+        out << prefix << "setGeometries," << geometries.toCsv() << '\n';
+
+        const auto relayout = qskMeasureRelayout( window, tree, options );
+        out << prefix << "relayout," << relayout.toCsv() << '\n';
+
+        out.flush();
+
+        delete tree.root;
+    }
+
+    const int labelCount = qMax( parser.value( "labels" ).toInt(), 0 );
+    if ( labelCount > 0 )
+    {
+        QskWindow window;
+        window.setAutoLayoutChildren( false );
+
+        const int columns = qCeil( std::sqrt( qreal( labelCount ) ) );
+
+        auto box = new QskLinearBox( Qt::Horizontal, columns );
+        window.addItem( box );
+
+        QVector< QskTextLabel* > labels;
+        labels.reserve( labelCount );
+
+        for ( int i = 0; i < labelCount; i++ )
+            labels += new QskTextLabel( box );
+
+        qskSetTexts( labels );
+        box->setSize( box->effectiveSizeHint( Qt::PreferredSize ) );
+
+        const auto prefix = QStringLiteral( "labels,1,%1,none,0,%2," )
+            .arg( labelCount ).arg( labelCount + 1 );
+
+        window.setParallelPolish( false );
+
+        const auto polish = qskMeasureLabels( window, labels, options );
+        out << prefix << "polish," << polish.toCsv() << '\n';
+
+        window.setParallelPolish( true );
+
+        const auto parallelPolish = qskMeasureLabels( window, labels, options );
+        out << prefix << "parallelPolish," << parallelPolish.toCsv() << '\n';
+
+        out.flush();
+
+        const auto geometries = qskGeometries( window, labels, false );
+        const auto parallelGeometries = qskGeometries( window, labels, true );
+
+        int check = 0;
+        for ( int i = 0; i < labelCount; i++ )
+        {
+            if ( geometries[ i ] != parallelGeometries[ i ] )
+                check++;
+        }
+
+        if ( check )
+        {
+            qWarning( "%d labels are laid out differently", check );
+            return 1;
+        }
+    }
+
+    return 0;
+}
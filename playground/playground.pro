@@ -2,10 +2,15 @@ TEMPLATE = subdirs
 
 SUBDIRS += \
     anchors \
+    boxbenchmark \
     dialogbuttons \
     invoker \
     inputpanel \
-    images
+    images \
+    layoutbenchmark \
+    hctbenchmark \
+    qvgbenchmark \
+    skinhintbenchmark
 
 SUBDIRS += shadows
 
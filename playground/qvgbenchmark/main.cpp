@@ -0,0 +1,260 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+/*
+    A benchmark for the cold start of qvg files, comparing the
+    formats of QskGraphicIO:
+
+        - load: reading all files into QskGraphics
+
+        - loadAndRender: reading all files and rendering each graphic
+          once into an image, what is the situation of an application
+          showing its icons for the first time
+
+    The graphics are either synthetic ones or loaded from the qvg files
+    passed on the command line. They are written in both formats to a
+    temporary directory before measuring.
+
+    The results are written as CSV to stdout.
+ */
+
+#include "Benchmark.h"
+
+#include <QskGraphic.h>
+#include <QskGraphicIO.h>
+
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QImage>
+#include <QPainter>
+#include <QPainterPath>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QVector>
+
+namespace
+{
+    class Random
+    {
+      public:
+        Random( quint32 seed )
+            : m_value( seed )
+        {
+        }
+
+        qreal value( qreal max )
+        {
+            m_value = m_value * 1664525u + 1013904223u;
+            return max * ( m_value >> 8 ) / qreal( 1 << 24 );
+        }
+
+      private:
+        quint32 m_value;
+    };
+}
+
+static QskGraphic qskSyntheticGraphic( int index, int pathCount )
+{
+    Random random( index + 1 );
+
+    QskGraphic graphic;
+
+    QPainter painter( &graphic );
+    painter.setRenderHint( QPainter::Antialiasing, true );
+
+    for ( int i = 0; i < pathCount; i++ )
+    {
+        QPainterPath path;
+        path.moveTo( random.value( 100 ), random.value( 100 ) );
+
+        for ( int j = 0; j < 4; j++ )
+        {
+            if ( ( i + j ) % 2 )
+            {
+                path.cubicTo( random.value( 100 ), random.value( 100 ),
+                    random.value( 100 ), random.value( 100 ),
+                    random.value( 100 ), random.value( 100 ) );
+            }
+            else
+            {
+                path.lineTo( random.value( 100 ), random.value( 100 ) );
+            }
+        }
+
+        path.closeSubpath();
+
+        const QColor color = QColor::fromHsv( int( random.value( 359 ) ), 200, 200 );
+
+        if ( i % 3 == 0 )
+        {
+            painter.setPen( QPen( color.darker(), 1.0 + random.value( 3 ) ) );
+            painter.setBrush( Qt::NoBrush );
+        }
+        else
+        {
+            painter.setPen( Qt::NoPen );
+            painter.setBrush( color );
+        }
+
+        painter.drawPath( path );
+    }
+
+    painter.end();
+
+    return graphic;
+}
+
+static Samples qskMeasure( const QStringList& files, int iterations,
+    const QSize& size, bool render, QVector< QImage >& images )
+{
+    Samples samples;
+
+    for ( int i = 0; i < iterations; i++ )
+    {
+        images.clear();
+
+        QElapsedTimer timer;
+        timer.start();
+
+        for ( const auto& file : files )
+        {
+            const auto graphic = QskGraphicIO::read( file );
+
+            if ( render )
+            {
+                QImage image( size, QImage::Format_ARGB32_Premultiplied );
+                image.fill( Qt::transparent );
+
+                QPainter painter( &image );
+                graphic.render( &painter, QRectF( QPointF(), size ), Qt::KeepAspectRatio );
+                painter.end();
+
+                images += image;
+            }
+        }
+
+        samples.add( timer.nsecsElapsed() );
+    }
+
+    return samples;
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+    QGuiApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Benchmarking the cold start of qvg files" );
+    parser.addHelpOption();
+
+    parser.addOptions( {
+        { "files", "Number of synthetic graphics", "count", "100" },
+        { "paths", "Number of paths of each synthetic graphic", "count", "50" },
+        { "size", "Size of the rendered images", "pixels", "48" },
+        { "iterations", "Number of measurements", "count", "20" },
+        { "header", "Write the CSV header" }
+    } );
+
+    parser.addPositionalArgument( "qvgfiles", "Using qvg files instead of synthetic graphics" );
+
+    parser.process( app );
+
+    const int iterations = qMax( parser.value( "iterations" ).toInt(), 1 );
+    const int extent = qMax( parser.value( "size" ).toInt(), 1 );
+
+    QVector< QskGraphic > graphics;
+
+    const auto inputFiles = parser.positionalArguments();
+    if ( inputFiles.isEmpty() )
+    {
+        const int fileCount = qMax( parser.value( "files" ).toInt(), 1 );
+        const int pathCount = qMax( parser.value( "paths" ).toInt(), 1 );
+
+        for ( int i = 0; i < fileCount; i++ )
+            graphics += qskSyntheticGraphic( i, pathCount );
+    }
+    else
+    {
+        for ( const auto& file : inputFiles )
+            graphics += QskGraphicIO::read( file );
+    }
+
+    QTemporaryDir dir;
+    if ( !dir.isValid() )
+    {
+        qWarning( "Can't create a temporary directory" );
+        return 1;
+    }
+
+    QStringList streamFiles, mappedFiles;
+
+    for ( int i = 0; i < graphics.count(); i++ )
+    {
+        const auto name = QStringLiteral( "%1.qvg" ).arg( i );
+
+        streamFiles += dir.filePath( QStringLiteral( "stream-" ) + name );
+        QskGraphicIO::write( graphics[ i ], streamFiles.last(), QskGraphicIO::Stream );
+
+        mappedFiles += dir.filePath( QStringLiteral( "mapped-" ) + name );
+        QskGraphicIO::write( graphics[ i ], mappedFiles.last(), QskGraphicIO::Mapped );
+    }
+
+    QTextStream out( stdout );
+
+    if ( parser.isSet( "header" ) )
+        out << "format,operation,files,iterations,min_ns,median_ns,mean_ns\n";
+
+    const QSize size( extent, extent );
+    const auto fileCount = graphics.count();
+
+    QVector< QImage > streamImages, mappedImages;
+
+    const struct
+    {
+        const char* format;
+        const QStringList& files;
+        QVector< QImage >& images;
+    } formats[] =
+    {
+        { "stream", streamFiles, streamImages },
+        { "mapped", mappedFiles, mappedImages }
+    };
+
+    for ( const auto& format : formats )
+    {
+        const auto loadSamples = qskMeasure(
+            format.files, iterations, size, false, format.images );
+
+        out << format.format << ",load," << fileCount << ','
+            << loadSamples.toCsv() << '\n';
+
+        const auto renderSamples = qskMeasure(
+            format.files, iterations, size, true, format.images );
+
+        out << format.format << ",loadAndRender," << fileCount << ','
+            << renderSamples.toCsv() << '\n';
+    }
+
+    out.flush();
+
+    int check = 0;
+    for ( int i = 0; i < fileCount; i++ )
+    {
+        if ( streamImages[ i ] != mappedImages[ i ] )
+            check++;
+    }
+
+    if ( check )
+    {
+        qWarning( "%d graphics are rendered differently", check );
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,216 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the 3-clause BSD License
+ *****************************************************************************/
+
+/*
+    A benchmark for the lookups of skin hints, comparing the hash map
+    of QskSkinHintTable with its compact representation:
+
+        - hash: resolvedHint from a table, that has not been compacted
+
+        - flat: resolvedHint from the compact table
+
+        - typed: resolvedMetric/resolvedColor from the compact table,
+          what does not unwrap any QVariant
+
+    The aspects are the metrics and colors of the skins combined with
+    all states being used in the skin, so that most lookups have
+    to go through the fallback chain like it happens for controls
+    in a non trivial state.
+
+    The results are written as CSV to stdout.
+ */
+
+#include "Benchmark.h"
+
+#include <QskSkin.h>
+#include <QskSkinHintTable.h>
+#include <QskSkinManager.h>
+
+#include <QColor>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QTextStream>
+#include <QVector>
+
+#include <memory>
+
+namespace
+{
+    // preventing the compiler from optimizing the lookups away
+    volatile double qskSink = 0.0;
+}
+
+static QVector< QskAspect > qskLookupAspects( const QskSkinHintTable& table )
+{
+    QVector< QskAspect > aspects;
+
+    const auto states = table.states();
+
+    for ( const auto& hint : table.hints() )
+    {
+        auto aspect = hint.first;
+
+        if ( aspect.isAnimator() || !( aspect.isMetric() || aspect.isColor() ) )
+            continue;
+
+        aspect.clearStates();
+
+        aspects += aspect;
+
+        for ( int bit = QskAspect::FirstSystemState;
+            bit <= QskAspect::LastSystemState; bit <<= 1 )
+        {
+            if ( states & bit )
+                aspects += aspect | static_cast< QskAspect::State >( bit );
+        }
+    }
+
+    return aspects;
+}
+
+static double qskLookupVariants(
+    const QskSkinHintTable& table, const QVector< QskAspect >& aspects )
+{
+    double sum = 0.0;
+
+    for ( const auto aspect : aspects )
+    {
+        if ( const auto value = table.resolvedHint( aspect ) )
+        {
+            if ( aspect.isMetric() )
+                sum += value->value< qreal >();
+            else
+                sum += value->value< QColor >().rgba();
+        }
+    }
+
+    return sum;
+}
+
+static double qskLookupTyped(
+    const QskSkinHintTable& table, const QVector< QskAspect >& aspects )
+{
+    double sum = 0.0;
+
+    for ( const auto aspect : aspects )
+    {
+        if ( aspect.isMetric() )
+        {
+            qreal metric;
+            if ( table.resolvedMetric( aspect, metric ) )
+                sum += metric;
+        }
+        else
+        {
+            QRgb rgb;
+            if ( table.resolvedColor( aspect, rgb ) )
+                sum += rgb;
+        }
+    }
+
+    return sum;
+}
+
+template< typename Lookup >
+static Samples qskMeasure( int iterations, Lookup lookup )
+{
+    Samples samples;
+
+    for ( int i = 0; i < iterations; i++ )
+    {
+        QElapsedTimer timer;
+        timer.start();
+
+        qskSink = qskSink + lookup();
+
+        samples.add( timer.nsecsElapsed() );
+    }
+
+    return samples;
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+    QGuiApplication app( argc, argv );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription( "Benchmarking the lookups of skin hints" );
+    parser.addHelpOption();
+
+    parser.addOptions( {
+        { "iterations", "Number of measurements", "count", "50" },
+        { "header", "Write the CSV header" }
+    } );
+
+    parser.addPositionalArgument( "skins",
+        "Skins to be measured, default: squiek material3Light" );
+
+    parser.process( app );
+
+    const int iterations = qMax( parser.value( "iterations" ).toInt(), 1 );
+
+    auto skinNames = parser.positionalArguments();
+    if ( skinNames.isEmpty() )
+        skinNames = QStringList { "squiek", "material3Light" };
+
+    QTextStream out( stdout );
+
+    if ( parser.isSet( "header" ) )
+        out << "skin,lookup,aspects,iterations,min_ns,median_ns,mean_ns\n";
+
+    int errors = 0;
+
+    for ( const auto& skinName : skinNames )
+    {
+        std::unique_ptr< QskSkin > skin( qskSkinManager->createSkin( skinName ) );
+        if ( skin == nullptr )
+        {
+            qWarning() << "Unknown skin:" << skinName;
+            errors++;
+
+            continue;
+        }
+
+        // createSkin has compacted the table of the skin already
+        const auto& flatTable = skin->hintTable();
+
+        QskSkinHintTable hashTable;
+        for ( const auto& hint : flatTable.hints() )
+            hashTable.setHint( hint.first, hint.second );
+
+        const auto aspects = qskLookupAspects( flatTable );
+
+        if ( qskLookupVariants( hashTable, aspects )
+            != qskLookupTyped( flatTable, aspects ) )
+        {
+            qWarning() << skinName << ": the lookups have different results";
+            errors++;
+        }
+
+        const auto prefix = QStringLiteral( "%1,%2,%3," );
+
+        out << prefix.arg( skinName, "hash" ).arg( aspects.count() )
+            << qskMeasure( iterations,
+                [&]() { return qskLookupVariants( hashTable, aspects ); } ).toCsv()
+            << '\n';
+
+        out << prefix.arg( skinName, "flat" ).arg( aspects.count() )
+            << qskMeasure( iterations,
+                [&]() { return qskLookupVariants( flatTable, aspects ); } ).toCsv()
+            << '\n';
+
+        out << prefix.arg( skinName, "typed" ).arg( aspects.count() )
+            << qskMeasure( iterations,
+                [&]() { return qskLookupTyped( flatTable, aspects ); } ).toCsv()
+            << '\n';
+    }
+
+    return errors ? 1 : 0;
+}
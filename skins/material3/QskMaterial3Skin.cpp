@@ -844,71 +844,76 @@ QskMaterial3Theme::QskMaterial3Theme(Lightness lightness,
                                     std::array<QskHctColor, NumPaletteTypes> palettes )
     : m_palettes( palettes )
 {
+    std::array< QskTonalPalette, NumPaletteTypes > tonalPalettes;
+
+    for ( int i = 0; i < NumPaletteTypes; i++ )
+        tonalPalettes[ i ] = QskTonalPalette( m_palettes[ i ] );
+
     if ( lightness == Light )
     {
-        primary = m_palettes[ Primary ].toned( 40 ).rgb();
-        onPrimary = m_palettes[ Primary ].toned( 100 ).rgb();
-        primaryContainer = m_palettes[ Primary ].toned( 90 ).rgb();
-        onPrimaryContainer = m_palettes[ Primary ].toned( 10 ).rgb();
-
-        secondary = m_palettes[ Secondary ].toned( 40 ).rgb();
-        onSecondary = m_palettes[ Secondary ].toned( 100 ).rgb();
-        secondaryContainer = m_palettes[ Secondary ].toned( 90 ).rgb();
-        onSecondaryContainer = m_palettes[ Secondary ].toned( 10 ).rgb();
-
-        tertiary = m_palettes[ Tertiary ].toned( 40 ).rgb();
-        onTertiary = m_palettes[ Tertiary ].toned( 100 ).rgb();
-        tertiaryContainer = m_palettes[ Tertiary ].toned( 90 ).rgb();
-        onTertiaryContainer = m_palettes[ Tertiary ].toned( 10 ).rgb();
-
-        error = m_palettes[ Error ].toned( 40 ).rgb();
-        onError = m_palettes[ Error ].toned( 100 ).rgb();
-        errorContainer = m_palettes[ Error ].toned( 90 ).rgb();
-        onErrorContainer = m_palettes[ Error ].toned( 10 ).rgb();
-
-        background = m_palettes[ Neutral ].toned( 99 ).rgb();
-        onBackground = m_palettes[ Neutral ].toned( 10 ).rgb();
-        surface = m_palettes[ Neutral ].toned( 99 ).rgb();
-        onSurface = m_palettes[ Neutral ].toned( 10 ).rgb();
-
-        surfaceVariant = m_palettes[ NeutralVariant ].toned( 90 ).rgb();
-        onSurfaceVariant = m_palettes[ NeutralVariant ].toned( 30 ).rgb();
-        outline = m_palettes[ NeutralVariant ].toned( 50 ).rgb();
-
-        shadow = m_palettes[ Neutral ].toned( 0 ).rgb();
+        primary = tonalPalettes[ Primary ].rgb( 40 );
+        onPrimary = tonalPalettes[ Primary ].rgb( 100 );
+        primaryContainer = tonalPalettes[ Primary ].rgb( 90 );
+        onPrimaryContainer = tonalPalettes[ Primary ].rgb( 10 );
+
+        secondary = tonalPalettes[ Secondary ].rgb( 40 );
+        onSecondary = tonalPalettes[ Secondary ].rgb( 100 );
+        secondaryContainer = tonalPalettes[ Secondary ].rgb( 90 );
+        onSecondaryContainer = tonalPalettes[ Secondary ].rgb( 10 );
+
+        tertiary = tonalPalettes[ Tertiary ].rgb( 40 );
+        onTertiary = tonalPalettes[ Tertiary ].rgb( 100 );
+        tertiaryContainer = tonalPalettes[ Tertiary ].rgb( 90 );
+        onTertiaryContainer = tonalPalettes[ Tertiary ].rgb( 10 );
+
+        error = tonalPalettes[ Error ].rgb( 40 );
+        onError = tonalPalettes[ Error ].rgb( 100 );
+        errorContainer = tonalPalettes[ Error ].rgb( 90 );
+        onErrorContainer = tonalPalettes[ Error ].rgb( 10 );
+
+        background = tonalPalettes[ Neutral ].rgb( 99 );
+        onBackground = tonalPalettes[ Neutral ].rgb( 10 );
+        surface = tonalPalettes[ Neutral ].rgb( 99 );
+        onSurface = tonalPalettes[ Neutral ].rgb( 10 );
+
+        surfaceVariant = tonalPalettes[ NeutralVariant ].rgb( 90 );
+        onSurfaceVariant = tonalPalettes[ NeutralVariant ].rgb( 30 );
+        outline = tonalPalettes[ NeutralVariant ].rgb( 50 );
+
+        shadow = tonalPalettes[ Neutral ].rgb( 0 );
     }
     else if ( lightness == Dark )
     {
-        primary = m_palettes[ Primary ].toned( 80 ).rgb();
-        onPrimary = m_palettes[ Primary ].toned( 20 ).rgb();
-        primaryContainer = m_palettes[ Primary ].toned( 30 ).rgb();
-        onPrimaryContainer = m_palettes[ Primary ].toned( 90 ).rgb();
-
-        secondary = m_palettes[ Secondary ].toned( 80 ).rgb();
-        onSecondary = m_palettes[ Secondary ].toned( 20 ).rgb();
-        secondaryContainer = m_palettes[ Secondary ].toned( 30 ).rgb();
-        onSecondaryContainer = m_palettes[ Secondary ].toned( 90 ).rgb();
-
-        tertiary = m_palettes[ Tertiary ].toned( 80 ).rgb();
-        onTertiary = m_palettes[ Tertiary ].toned( 20 ).rgb();
-        tertiaryContainer = m_palettes[ Tertiary ].toned( 30 ).rgb();
-        onTertiaryContainer = m_palettes[ Tertiary ].toned( 90 ).rgb();
-
-        error = m_palettes[ Error ].toned( 80 ).rgb();
-        onError = m_palettes[ Error ].toned( 20 ).rgb();
-        errorContainer = m_palettes[ Error ].toned( 30 ).rgb();
-        onErrorContainer = m_palettes[ Error ].toned( 90 ).rgb();
-
-        background = m_palettes[ Neutral ].toned( 10 ).rgb();
-        onBackground = m_palettes[ Neutral ].toned( 90 ).rgb();
-        surface = m_palettes[ Neutral ].toned( 10 ).rgb();
-        onSurface = m_palettes[ Neutral ].toned( 80 ).rgb();
-
-        surfaceVariant = m_palettes[ NeutralVariant ].toned( 30 ).rgb();
-        onSurfaceVariant = m_palettes[ NeutralVariant ].toned( 80 ).rgb();
-        outline = m_palettes[ NeutralVariant ].toned( 60 ).rgb();
-
-        shadow = m_palettes[ Neutral ].toned( 0 ).rgb();
+        primary = tonalPalettes[ Primary ].rgb( 80 );
+        onPrimary = tonalPalettes[ Primary ].rgb( 20 );
+        primaryContainer = tonalPalettes[ Primary ].rgb( 30 );
+        onPrimaryContainer = tonalPalettes[ Primary ].rgb( 90 );
+
+        secondary = tonalPalettes[ Secondary ].rgb( 80 );
+        onSecondary = tonalPalettes[ Secondary ].rgb( 20 );
+        secondaryContainer = tonalPalettes[ Secondary ].rgb( 30 );
+        onSecondaryContainer = tonalPalettes[ Secondary ].rgb( 90 );
+
+        tertiary = tonalPalettes[ Tertiary ].rgb( 80 );
+        onTertiary = tonalPalettes[ Tertiary ].rgb( 20 );
+        tertiaryContainer = tonalPalettes[ Tertiary ].rgb( 30 );
+        onTertiaryContainer = tonalPalettes[ Tertiary ].rgb( 90 );
+
+        error = tonalPalettes[ Error ].rgb( 80 );
+        onError = tonalPalettes[ Error ].rgb( 20 );
+        errorContainer = tonalPalettes[ Error ].rgb( 30 );
+        onErrorContainer = tonalPalettes[ Error ].rgb( 90 );
+
+        background = tonalPalettes[ Neutral ].rgb( 10 );
+        onBackground = tonalPalettes[ Neutral ].rgb( 90 );
+        surface = tonalPalettes[ Neutral ].rgb( 10 );
+        onSurface = tonalPalettes[ Neutral ].rgb( 80 );
+
+        surfaceVariant = tonalPalettes[ NeutralVariant ].rgb( 30 );
+        onSurfaceVariant = tonalPalettes[ NeutralVariant ].rgb( 80 );
+        outline = tonalPalettes[ NeutralVariant ].rgb( 60 );
+
+        shadow = tonalPalettes[ Neutral ].rgb( 0 );
     }
 
     primary12 = primary;
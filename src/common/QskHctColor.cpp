@@ -1,6 +1,11 @@
 #include "QskHctColor.h"
 
+#include <qglobalstatic.h>
+#include <qhash.h>
 #include <qmath.h>
+#include <qmutex.h>
+
+#include <algorithm>
 #include <cmath>
 
 /*
@@ -62,6 +67,13 @@ namespace
     class ViewingConditions
     {
       public:
+        ViewingConditions()
+            : alphaCoeff( pow( 1.64 - pow( 0.29, backgroundYTowhitePointY ), 0.73 ) )
+            , tInnerCoeff( 1.0 / alphaCoeff )
+            , acExponent( 1.0 / 0.69 / z )
+            , jExponent( 0.69 * z )
+        {
+        }
 
         const double backgroundYTowhitePointY = 0.18418651851244416;
 
@@ -71,7 +83,36 @@ namespace
         const double fl = 0.38848145378003529;
 
         const XYZ rgbD = { 1.02117770275752, 0.98630772942801237, 0.93396050828022992 };
+
+        // derived values, that would otherwise be calculated for each color
+        const double alphaCoeff;
+        const double tInnerCoeff;
+        const double acExponent;
+        const double jExponent;
     };
+
+    /*
+        The parameters of the solver, that depend on the hue only.
+        They are shared, when calculating several tones of the same hue.
+     */
+    class HueParameters
+    {
+      public:
+        explicit HueParameters( double hue );
+
+        double hueRadians;
+
+        double hSin;
+        double hCos;
+        double p1;
+    };
+}
+
+static const ViewingConditions& qskViewingConditions()
+{
+    // the default viewing conditions, calculated only once
+    static const ViewingConditions vc;
+    return vc;
 }
 
 static const XYZ Y_FROM_LINRGB = { 0.2126, 0.7152, 0.0722 };
@@ -679,24 +720,35 @@ static double inverseChromaticAdaptation( double adapted )
     return signum(adapted) * pow( base, 1.0 / 0.42 );
 }
 
-static QRgb findResultByJ( double hueRadians, double chroma, double y )
+HueParameters::HueParameters( double hue )
 {
-    double j = sqrt(y) * 11.0;
+    const auto& vc = qskViewingConditions();
+
+    hueRadians = sanitizeDegreesDouble( hue ) / 180.0 * M_PI;
 
-    constexpr ViewingConditions vc;
+    hSin = sin( hueRadians );
+    hCos = cos( hueRadians );
 
-    const double tInnerCoeff = 1.0 / pow( 1.64 - pow( 0.29, vc.backgroundYTowhitePointY ), 0.73 );
     const double eHue = 0.25 * ( cos( hueRadians + 2.0 ) + 3.8 );
-    const double p1 = eHue * ( 50000.0 / 13.0 ) * vc.nbb;
-    const double hSin = sin(hueRadians);
-    const double hCos = cos(hueRadians);
+    p1 = eHue * ( 50000.0 / 13.0 ) * vc.nbb;
+}
+
+static QRgb findResultByJ( const HueParameters& hp, double chroma, double y )
+{
+    double j = sqrt(y) * 11.0;
+
+    const auto& vc = qskViewingConditions();
+
+    const double p1 = hp.p1;
+    const double hSin = hp.hSin;
+    const double hCos = hp.hCos;
 
     for ( int i = 0; i < 5; i++ )
     {
         const double jNormalized = j / 100.0;
         const double alpha = ( chroma == 0.0 || j == 0.0 ) ? 0.0 : chroma / sqrt(jNormalized);
-        const double t = pow( alpha * tInnerCoeff, 1.0 / 0.9 );
-        const double ac = vc.aw * pow( jNormalized, 1.0 / 0.69 / vc.z );
+        const double t = pow( alpha * vc.tInnerCoeff, 1.0 / 0.9 );
+        const double ac = vc.aw * pow( jNormalized, vc.acExponent );
         const double p2 = ac / vc.nbb;
 
         const double gamma = 23.0 * ( p2 + 0.305 ) * t /
@@ -747,24 +799,34 @@ static QRgb findResultByJ( double hueRadians, double chroma, double y )
     return 0;
 }
 
-static inline QRgb getRgb( double hue, double chroma, double tone )
+static inline bool isAchromatic( double chroma, double tone )
 {
-    if ( chroma < 0.0001 || tone < 0.0001 || tone > 99.9999 )
-        return argbFromLstar( tone );
+    return chroma < 0.0001 || tone < 0.0001 || tone > 99.9999;
+}
 
-    hue = sanitizeDegreesDouble( hue );
+static QRgb getRgb( const HueParameters& hp, double chroma, double tone )
+{
+    if ( isAchromatic( chroma, tone ) )
+        return argbFromLstar( tone );
 
-    const double hueRadians = hue / 180.0 * M_PI;
     const double y = yFromLstar( tone );
 
-    const QRgb rgb = findResultByJ( hueRadians, chroma, y );
+    const QRgb rgb = findResultByJ( hp, chroma, y );
     if ( rgb != 0 )
         return rgb;
 
-    const XYZ linrgb = bisectToLimit( y, hueRadians );
+    const XYZ linrgb = bisectToLimit( y, hp.hueRadians );
     return argbFromLinrgb( linrgb );
 }
 
+static inline QRgb getRgb( double hue, double chroma, double tone )
+{
+    if ( isAchromatic( chroma, tone ) )
+        return argbFromLstar( tone );
+
+    return getRgb( HueParameters( hue ), chroma, tone );
+}
+
 static const XYZ SRGB_TO_XYZ[3] =
 {
     { 0.41233895, 0.35762064, 0.18051042 },
@@ -795,7 +857,7 @@ static XYZ xyzFromArgb( QRgb rgb)
 
 static void getHTC( QRgb rgb, double& hue, double& chroma, double& tone )
 {
-    ViewingConditions vc;
+    const auto& vc = qskViewingConditions();
 
     const XYZ xyz = xyzFromArgb( rgb );
 
@@ -835,15 +897,14 @@ static void getHTC( QRgb rgb, double& hue, double& chroma, double& tone )
     {
         const double ac = p2 * vc.nbb;
 
-        const double J = 100.0 * pow( ac / vc.aw, 0.69 * vc.z );
+        const double J = 100.0 * pow( ac / vc.aw, vc.jExponent );
 
         const double huePrime = ( hue < 20.14 ) ? hue + 360 : hue;
         const double eHue = ( 1.0 / 4.0 ) * ( cos( huePrime * M_PI / 180.0 + 2.0 ) + 3.8 );
         const double p1 = 50000.0 / 13.0 * eHue * vc.nbb;
         const double t = p1 * sqrt(a * a + b * b) / ( u + 0.305 );
 
-        const double alpha =
-            pow(t, 0.9) * pow( 1.64 - pow(0.29, vc.backgroundYTowhitePointY), 0.73);
+        const double alpha = pow(t, 0.9) * vc.alphaCoeff;
 
         chroma = alpha * sqrt(J / 100.0);
     }
@@ -885,6 +946,133 @@ QRgb QskHctColor::rgb() const
     return getRgb( m_hue, m_chroma, m_tone );
 }
 
+void QskHctColor::rgbTones( int count, const qreal tones[], QRgb rgb[] ) const
+{
+    if ( count <= 0 )
+        return;
+
+    const HueParameters hp( m_hue );
+
+    for ( int i = 0; i < count; i++ )
+        rgb[i] = getRgb( hp, m_chroma, tones[i] );
+}
+
+namespace
+{
+    class PaletteKey
+    {
+      public:
+        inline bool operator==( const PaletteKey& other ) const noexcept
+        {
+            return ( hue == other.hue ) && ( chroma == other.chroma );
+        }
+
+        qreal hue;
+        qreal chroma;
+    };
+
+    inline QskHashValue qHash( const PaletteKey& key, QskHashValue seed = 0 ) noexcept
+    {
+        return ::qHash( key.chroma, ::qHash( key.hue, seed ) );
+    }
+
+    class PaletteTones
+    {
+      public:
+        QRgb rgb[ QskTonalPalette::ToneCount ];
+    };
+
+    class PaletteCache
+    {
+      public:
+        QMutex mutex;
+        QHash< PaletteKey, PaletteTones > palettes;
+    };
+}
+
+Q_GLOBAL_STATIC( PaletteCache, qskPaletteCache )
+
+static const qreal qskPaletteTones[] =
+    { 0, 10, 20, 30, 40, 50, 60, 70, 80, 90, 95, 99, 100 };
+
+static_assert( sizeof( qskPaletteTones ) / sizeof( qskPaletteTones[0] )
+    == QskTonalPalette::ToneCount, "Unexpected number of palette tones" );
+
+static inline int qskPaletteToneIndex( qreal tone )
+{
+    for ( int i = 0; i < QskTonalPalette::ToneCount; i++ )
+    {
+        if ( qskPaletteTones[i] == tone )
+            return i;
+    }
+
+    return -1;
+}
+
+QskTonalPalette::QskTonalPalette() noexcept
+{
+    for ( auto& rgb : m_rgb )
+        rgb = 0;
+}
+
+QskTonalPalette::QskTonalPalette( const QskHctColor& color )
+    : m_hue( color.hue() )
+    , m_chroma( color.chroma() )
+{
+    const PaletteKey key { m_hue, m_chroma };
+
+    if ( auto cache = qskPaletteCache() )
+    {
+        QMutexLocker locker( &cache->mutex );
+
+        auto it = cache->palettes.constFind( key );
+        if ( it != cache->palettes.constEnd() )
+        {
+            std::copy( it->rgb, it->rgb + ToneCount, m_rgb );
+            return;
+        }
+    }
+
+    color.rgbTones( ToneCount, qskPaletteTones, m_rgb );
+
+    if ( auto cache = qskPaletteCache() )
+    {
+        QMutexLocker locker( &cache->mutex );
+
+        // palettes usually come from a few key colors only
+        if ( cache->palettes.size() >= 64 )
+            cache->palettes.clear();
+
+        PaletteTones tones;
+        std::copy( m_rgb, m_rgb + ToneCount, tones.rgb );
+
+        cache->palettes.insert( key, tones );
+    }
+}
+
+qreal QskTonalPalette::tone( int index )
+{
+    return ( index >= 0 && index < ToneCount ) ? qskPaletteTones[index] : -1.0;
+}
+
+QRgb QskTonalPalette::rgb( qreal tone ) const
+{
+    const int index = qskPaletteToneIndex( tone );
+    if ( index >= 0 )
+        return m_rgb[index];
+
+    return QskHctColor( m_hue, m_chroma, tone ).rgb();
+}
+
+void QskTonalPalette::clearCache()
+{
+    if ( auto cache = qskPaletteCache() )
+    {
+        QMutexLocker locker( &cache->mutex );
+        cache->palettes.clear();
+    }
+}
+
 #ifndef QT_NO_DEBUG_STREAM
 
 #include <qdebug.h>
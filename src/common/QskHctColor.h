@@ -44,6 +44,12 @@ class QSK_EXPORT QskHctColor
     void setRgb( QRgb );
     QRgb rgb() const;
 
+    /*
+        Calculating toned( tones[i] ).rgb() for several tones at once,
+        sharing what depends on hue and chroma only
+     */
+    void rgbTones( int count, const qreal tones[], QRgb rgb[] ) const;
+
   private:
     qreal m_hue = 0;    // [0.0, 360.0[
     qreal m_chroma = 0;
@@ -79,6 +85,49 @@ inline constexpr QskHctColor QskHctColor::toned( qreal tone ) const noexcept
     return QskHctColor( m_hue, m_chroma, tone );
 }
 
+/*
+    The RGB values of a tonal palette: the tones 0, 10, 20, ... 90, 95, 99, 100
+    of a hue/chroma are calculated in one call and can be looked up afterwards.
+    Other tones are calculated on request.
+
+    As applications usually switch between a few key colors only,
+    the palettes are cached.
+ */
+class QSK_EXPORT QskTonalPalette
+{
+  public:
+    enum { ToneCount = 13 };
+
+    QskTonalPalette() noexcept;
+    QskTonalPalette( const QskHctColor& );
+
+    constexpr qreal hue() const noexcept;
+    constexpr qreal chroma() const noexcept;
+
+    QRgb rgb( qreal tone ) const;
+
+    static qreal tone( int index );
+    static void clearCache();
+
+  private:
+    qreal m_hue = 0;
+    qreal m_chroma = 0;
+
+    QRgb m_rgb[ ToneCount ];
+};
+
+Q_DECLARE_TYPEINFO( QskTonalPalette, Q_MOVABLE_TYPE );
+
+inline constexpr qreal QskTonalPalette::hue() const noexcept
+{
+    return m_hue;
+}
+
+inline constexpr qreal QskTonalPalette::chroma() const noexcept
+{
+    return m_chroma;
+}
+
 #ifndef QT_NO_DEBUG_STREAM
     class QDebug;
     QSK_EXPORT QDebug operator<<( QDebug, const QskHctColor& );
@@ -4,14 +4,18 @@
  *****************************************************************************/
 
 #include "QskAnimator.h"
+#include "QskFrameStatistics.h"
 
 #include <qelapsedtimer.h>
 #include <qglobalstatic.h>
+#include <qhash.h>
 #include <qobject.h>
 #include <qquickwindow.h>
 #include <qvector.h>
 
 #include <cmath>
+#include <memory>
+#include <unordered_map>
 
 #ifndef QT_NO_DEBUG_STREAM
 #include <qdebug.h>
@@ -70,6 +74,30 @@ namespace
 
 namespace
 {
+    /*
+        The animators of a window. Registering and unregistering are
+        done in constant time by remembering the position of each animator.
+
+        While advancing, the vector must not be reordered: removed animators
+        leave a gap, that is cleaned up afterwards, and animators, that are
+        added, are appended and will be advanced with the next frame.
+     */
+    class AnimatorBucket
+    {
+      public:
+        bool insert( QskAnimator* );
+        bool remove( const QskAnimator* );
+
+        void compact();
+
+        QVector< QskAnimator* > animators;
+        QHash< const QskAnimator*, int > indexes;
+
+        bool isAdvancing = false;
+        bool hasGaps = false;
+        bool isRemoved = false;
+    };
+
     /*
         We need to have at least one QObject to connect to QQuickWindow
         updates - but then we can advance the animators manually without
@@ -98,19 +126,77 @@ namespace
 
         QElapsedTimer m_referenceTime;
 
-        // a sorted vector, good for iterating and good enough for look ups
-        QVector< QskAnimator* > m_animators;
-
-        /*
-           Having a more than a very few windows with running animators is
-           very unlikely and using a hash table instead of a vector probably
-           creates more overhead than being good for something.
-         */
-        QVector< QQuickWindow* > m_windows;
-        mutable int m_index = -1; // current value, when iterating
+        // buckets are allocated, so that they stay valid while iterating
+        std::unordered_map< const QQuickWindow*,
+            std::unique_ptr< AnimatorBucket > > m_buckets;
     };
 }
 
+bool AnimatorBucket::insert( QskAnimator* animator )
+{
+    if ( indexes.contains( animator ) )
+        return false;
+
+    indexes.insert( animator, animators.size() );
+    animators += animator;
+
+    return true;
+}
+
+bool AnimatorBucket::remove( const QskAnimator* animator )
+{
+    const auto it = indexes.find( animator );
+    if ( it == indexes.end() )
+        return false;
+
+    const int index = it.value();
+    indexes.erase( it );
+
+    if ( isAdvancing )
+    {
+        animators[ index ] = nullptr;
+        hasGaps = true;
+    }
+    else
+    {
+        // moving the last animator into the gap
+        const auto last = animators.takeLast();
+
+        if ( index < animators.size() )
+        {
+            animators[ index ] = last;
+            indexes[ last ] = index;
+        }
+    }
+
+    return true;
+}
+
+void AnimatorBucket::compact()
+{
+    if ( !hasGaps )
+        return;
+
+    int count = 0;
+
+    for ( int i = 0; i < animators.size(); i++ )
+    {
+        if ( auto animator = animators[ i ] )
+        {
+            if ( i != count )
+            {
+                animators[ count ] = animator;
+                indexes[ animator ] = count;
+            }
+
+            count++;
+        }
+    }
+
+    animators.resize( count );
+    hasGaps = false;
+}
+
 AnimatorDriver::AnimatorDriver()
 {
     m_referenceTime.start();
@@ -127,104 +213,130 @@ void AnimatorDriver::registerAnimator( QskAnimator* animator )
 
     // do we want to be thread safe ???
 
-    auto it = std::lower_bound( m_animators.begin(), m_animators.end(), animator );
-    if ( it != m_animators.end() && *it == animator )
+    auto window = animator->window();
+    if ( window == nullptr )
         return;
 
-    if ( m_index > 0 )
-    {
-        if ( it - m_animators.begin() < m_index )
-            m_index++;
-    }
-
-    m_animators.insert( it, animator );
+    auto& bucket = m_buckets[ window ];
 
-    if ( auto window = animator->window() )
+    if ( bucket == nullptr || bucket->isRemoved )
     {
-        if ( !m_windows.contains( window ) )
-        {
-            m_windows += window;
+        if ( bucket == nullptr )
+            bucket.reset( new AnimatorBucket() );
 
-            connect( window, &QQuickWindow::afterAnimating,
-                this, [ this, window ]() { advanceAnimators( window ); } );
+        bucket->isRemoved = false;
 
-            connect( window, &QQuickWindow::frameSwapped,
-                this, [ this, window ]() { scheduleUpdate( window ); } );
+        connect( window, &QQuickWindow::afterAnimating,
+            this, [ this, window ]() { advanceAnimators( window ); } );
 
-            connect( window, &QWindow::visibleChanged,
-                this, [ this, window ]( bool on ) { if ( !on ) removeWindow( window ); } );
+        connect( window, &QQuickWindow::frameSwapped,
+            this, [ this, window ]() { scheduleUpdate( window ); } );
 
-            connect( window, &QObject::destroyed,
-                this, [ this, window ]( QObject* ) { removeWindow( window ); } );
+        connect( window, &QWindow::visibleChanged,
+            this, [ this, window ]( bool on ) { if ( !on ) removeWindow( window ); } );
 
-            window->update();
-        }
+        connect( window, &QObject::destroyed,
+            this, [ this, window ]( QObject* ) { removeWindow( window ); } );
+
+        window->update();
     }
+
+    bucket->insert( animator );
 }
 
 void AnimatorDriver::scheduleUpdate( QQuickWindow* window )
 {
-    if ( m_windows.contains( window ) )
+    if ( m_buckets.find( window ) != m_buckets.end() )
         window->update();
 }
 
 void AnimatorDriver::removeWindow( QQuickWindow* window )
 {
     window->disconnect( this );
-    m_windows.removeOne( window );
 
-    for ( auto it = m_animators.begin(); it != m_animators.end(); )
+    auto it = m_buckets.find( window );
+    if ( it == m_buckets.end() )
+        return;
+
+    auto bucket = it->second.get();
+
+    if ( bucket->isAdvancing )
+    {
+        // the bucket is deleted, when advanceAnimators is done
+        for ( auto& animator : bucket->animators )
+            animator = nullptr;
+
+        bucket->indexes.clear();
+        bucket->hasGaps = bucket->isRemoved = true;
+    }
+    else
     {
-        if ( ( *it )->window() == window )
-            it = m_animators.erase( it );
-        else
-            ++it;
+        m_buckets.erase( it );
     }
 }
 
 void AnimatorDriver::unregisterAnimator( QskAnimator* animator )
 {
-    auto it = std::find( m_animators.begin(), m_animators.end(), animator );
-    if ( it != m_animators.end() )
-    {
-        if ( it - m_animators.begin() < m_index )
-            m_index--;
-
-        m_animators.erase( it );
-    }
+    /*
+        As QskAnimator::setWindow stops the animator before changing
+        the window, the animator can always be found in the bucket
+        of its current window.
+     */
+    auto it = m_buckets.find( animator->window() );
+    if ( it != m_buckets.end() )
+        it->second->remove( animator );
 }
 
 void AnimatorDriver::advanceAnimators( QQuickWindow* window )
 {
-    bool hasAnimators = false;
+    auto it = m_buckets.find( window );
+    if ( it == m_buckets.end() )
+        return;
+
+    auto bucket = it->second.get();
+    if ( bucket->isAdvancing )
+        return;
+
     bool hasTerminations = false;
+    int advancedCount = 0;
+
+    const bool hasAnimators = !bucket->indexes.isEmpty();
 
-    for ( m_index = m_animators.size() - 1; m_index >= 0; m_index-- )
+    bucket->isAdvancing = true;
+
+    /*
+        Advancing animators might create/remove animators, what is handled
+        by AnimatorBucket without changing the positions of the others.
+        Animators, that have been added in the meantime, are not advanced
+        before the next frame.
+     */
+    const int count = bucket->animators.size();
+
+    for ( int i = 0; i < count; i++ )
     {
-        // Advancing animators might create/remove animators, what is handled by
-        // adjusting m_index in register/unregister
+        auto animator = bucket->animators[ i ];
 
-        auto animator = m_animators[ m_index ];
-        if ( animator->window() == window )
+        if ( animator && animator->isRunning() )
         {
-            hasAnimators = true;
+            animator->update();
+            advancedCount++;
 
-            if ( animator->isRunning() )
-            {
-                animator->update();
-
-                if ( !animator->isRunning() )
-                    hasTerminations = true;
-            }
+            if ( !animator->isRunning() )
+                hasTerminations = true;
         }
     }
 
-    m_index = -1;
+    bucket->isAdvancing = false;
+    bucket->compact();
 
-    if ( !hasAnimators )
+    QskFrameStatistics::count( window, QskFrameStatistics::AdvancedAnimators, advancedCount );
+
+    if ( bucket->isRemoved || !hasAnimators )
     {
-        window->disconnect( this );
-        m_windows.removeOne( const_cast< QQuickWindow* >( window ) );
+        if ( !bucket->isRemoved )
+            window->disconnect( this );
+
+        m_buckets.erase( window );
     }
 
     Q_EMIT advanced( window );
@@ -130,7 +130,7 @@ QSGNode* QskCheckBoxSkinlet::updateIndicatorNode(
      */
     QskColorFilter filter;
     filter.addColorSubstitution( Qt::black,
-        checkBox->color( QskCheckBox::Indicator ).rgba() );
+        checkBox->rgb( QskCheckBox::Indicator ) );
 
     graphic = QskGraphic::fromGraphic( graphic, filter );
 #endif
@@ -14,6 +14,7 @@
 #include "QskSkin.h"
 #include "QskSkinlet.h"
 #include "QskSkinHintTable.h"
+#include "QskSubcontrolIndex.h"
 #include "QskMargins.h"
 
 #include <qlocale.h>
@@ -40,10 +41,16 @@ QskControl::QskControl( QQuickItem* parent )
         QskControlPrivate::resolveLocale( this );
         QskControlPrivate::resolveSection( this );
     }
+
+    if ( auto index = QskSubcontrolIndex::instance() )
+        index->insert( this );
 }
 
 QskControl::~QskControl()
 {
+    if ( auto index = QskSubcontrolIndex::instance() )
+        index->remove( this );
+
 #if defined( QT_DEBUG )
     if ( auto w = window() )
     {
@@ -63,6 +70,10 @@ void QskControl::setAutoFillBackground( bool on )
     if ( on != d->autoFillBackground )
     {
         d->autoFillBackground = on;
+
+        if ( auto index = QskSubcontrolIndex::instance() )
+            index->invalidate( this );
+
         update();
     }
 }
@@ -649,7 +660,7 @@ QSizeF QskControl::implicitSizeHint(
     }
     else
     {
-        hint = d_func()->implicitSizeHint( whichHint, constraint );
+        hint = d_func()->cachedImplicitSizeHint( whichHint, constraint );
     }
 
     return hint;
@@ -780,6 +791,9 @@ bool QskControl::event( QEvent* event )
         }
         case QEvent::LayoutRequest:
         {
+            // hints of children are involved
+            d_func()->invalidateSizeHintCache();
+
             if ( d_func()->autoLayoutChildren )
             {
                 resetImplicitSize();
@@ -4,6 +4,7 @@
  *****************************************************************************/
 
 #include "QskControlPrivate.h"
+#include "QskFrameStatistics.h"
 #include "QskSetup.h"
 #include "QskLayoutMetrics.h"
 #include "QskObjectTree.h"
@@ -149,8 +150,70 @@ void qskInheritSection( QskControl* control, QskAspect::Section section )
     custom controls in QML.
  */
 
+/*
+    Layout engines request the same hints over and over, while solving
+    their layout chains. As the implicit hints can only change, when
+    the implicit size gets reset or a child requests a new layout, we
+    keep the most recent results in a small cache. The unconstrained
+    preferred size is not stored here as it is the implicit size.
+ */
+class QskControlPrivate::SizeHintCache
+{
+  public:
+    inline bool find( Qt::SizeHint which,
+        const QSizeF& constraint, QSizeF& hint ) const
+    {
+        for ( int i = 0; i < m_count; i++ )
+        {
+            const auto& entry = m_entries[ i ];
+
+            if ( entry.which == which && entry.constraint == constraint )
+            {
+                hint = entry.hint;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    inline void insert( Qt::SizeHint which,
+        const QSizeF& constraint, const QSizeF& hint )
+    {
+        auto& entry = m_entries[ m_next ];
+
+        entry.which = which;
+        entry.constraint = constraint;
+        entry.hint = hint;
+
+        m_next = ( m_next + 1 ) % Capacity;
+        m_count = qMin( m_count + 1, int( Capacity ) );
+    }
+
+    inline void clear()
+    {
+        m_count = m_next = 0;
+    }
+
+  private:
+    enum { Capacity = 6 };
+
+    struct Entry
+    {
+        Qt::SizeHint which;
+        QSizeF constraint;
+        QSizeF hint;
+    };
+
+    Entry m_entries[ Capacity ];
+
+    int m_count = 0;
+    int m_next = 0;
+};
+
 QskControlPrivate::QskControlPrivate()
     : explicitSizeHints( nullptr )
+    , sizeHintCache( nullptr )
     , sizePolicy( QskSizePolicy::Preferred, QskSizePolicy::Preferred )
     , visiblePlacementPolicy( 0 )
     , hiddenPlacementPolicy( 0 )
@@ -168,10 +231,14 @@ QskControlPrivate::QskControlPrivate()
 QskControlPrivate::~QskControlPrivate()
 {
     delete [] explicitSizeHints;
+    delete sizeHintCache;
 }
 
 void QskControlPrivate::layoutConstraintChanged()
 {
+    // the implicit size might have been reset
+    invalidateSizeHintCache();
+
     if ( !blockLayoutRequestEvents )
     {
         Inherited::layoutConstraintChanged();
@@ -195,9 +262,43 @@ void QskControlPrivate::implicitSizeChanged()
 
 QSizeF QskControlPrivate::implicitSizeHint() const
 {
+    // being called, when the implicit size gets updated
+    invalidateSizeHintCache();
+
     return implicitSizeHint( Qt::PreferredSize, QSizeF() );
 }
 
+QSizeF QskControlPrivate::cachedImplicitSizeHint(
+    Qt::SizeHint which, const QSizeF& constraint ) const
+{
+    Q_Q( const QskControl );
+
+    QSizeF hint;
+
+    if ( sizeHintCache && sizeHintCache->find( which, constraint, hint ) )
+    {
+        QskFrameStatistics::count( q->window(), QskFrameStatistics::CachedSizeHints );
+        return hint;
+    }
+
+    QskFrameStatistics::count( q->window(), QskFrameStatistics::CalculatedSizeHints );
+
+    hint = implicitSizeHint( which, constraint );
+
+    if ( sizeHintCache == nullptr )
+        sizeHintCache = new SizeHintCache();
+
+    sizeHintCache->insert( which, constraint, hint );
+
+    return hint;
+}
+
+void QskControlPrivate::invalidateSizeHintCache() const
+{
+    if ( sizeHintCache )
+        sizeHintCache->clear();
+}
+
 QSizeF QskControlPrivate::implicitSizeHint(
     Qt::SizeHint which, const QSizeF& constraint ) const
 {
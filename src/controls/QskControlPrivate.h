@@ -33,6 +33,9 @@ class QskControlPrivate : public QskQuickItemPrivate
     QSizeF implicitSizeHint( Qt::SizeHint, const QSizeF& ) const;
     QSizeF implicitSizeHint() const override final;
 
+    QSizeF cachedImplicitSizeHint( Qt::SizeHint, const QSizeF& ) const;
+    void invalidateSizeHintCache() const;
+
     void implicitSizeChanged() override final;
     void layoutConstraintChanged() override final;
 
@@ -46,6 +49,9 @@ class QskControlPrivate : public QskQuickItemPrivate
 
     QSizeF* explicitSizeHints;
 
+    class SizeHintCache;
+    mutable SizeHintCache* sizeHintCache;
+
     QLocale locale;
 
     QskSizePolicy sizePolicy;
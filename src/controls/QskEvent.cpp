@@ -219,3 +219,27 @@ QskAnimatorEvent* QskAnimatorEvent::clone() const
 {
     return new QskAnimatorEvent( *this );
 }
+
+// -- QskLayoutRequestEvent
+
+QskLayoutRequestEvent::QskLayoutRequestEvent( const QQuickItem* item )
+    : QEvent( QEvent::LayoutRequest )
+    , m_item( item )
+{
+}
+
+QskLayoutRequestEvent* QskLayoutRequestEvent::clone() const
+{
+    return new QskLayoutRequestEvent( *this );
+}
+
+const QQuickItem* qskLayoutRequestItem( const QEvent* event )
+{
+    if ( event && event->type() == QEvent::LayoutRequest )
+    {
+        if ( auto request = dynamic_cast< const QskLayoutRequestEvent* >( event ) )
+            return request->item();
+    }
+
+    return nullptr;
+}
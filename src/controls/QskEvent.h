@@ -158,8 +158,36 @@ class QSK_EXPORT QskAnimatorEvent : public QskEvent
     State m_state;
 };
 
+/*
+    A QEvent::LayoutRequest, that is sent from a child to its parent, when
+    its layout relevant hints have changed. Layouts can use the
+    item to update the affected cells only.
+ */
+class QSK_EXPORT QskLayoutRequestEvent : public QEvent
+{
+  public:
+    QskLayoutRequestEvent( const QQuickItem* );
+
+    inline const QQuickItem* item() const { return m_item; }
+
+#if QT_VERSION < QT_VERSION_CHECK( 6, 0, 0 )
+    virtual QskLayoutRequestEvent* clone() const;
+#else
+    QskLayoutRequestEvent* clone() const override;
+#endif
+
+  protected:
+    QSK_EVENT_DISABLE_COPY( QskLayoutRequestEvent )
+
+  private:
+    const QQuickItem* m_item;
+};
+
 QSK_EXPORT int qskFocusChainIncrement( const QEvent* );
 
+// the item of a QskLayoutRequestEvent, or nullptr for other events
+QSK_EXPORT const QQuickItem* qskLayoutRequestItem( const QEvent* );
+
 // some helper to work around Qt version incompatibilities
 QSK_EXPORT QPointF qskMouseScenePosition( const QMouseEvent* );
 QSK_EXPORT QPointF qskMousePosition( const QMouseEvent* );
@@ -0,0 +1,295 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskFrameStatistics.h"
+
+#include <qelapsedtimer.h>
+#include <qfile.h>
+#include <qhash.h>
+#include <qmetaobject.h>
+#include <qmutex.h>
+#include <qpointer.h>
+#include <qquickwindow.h>
+#include <qtextstream.h>
+
+#include <atomic>
+
+static void qskRegisterFrameStatistics()
+{
+    qRegisterMetaType< QskFrameStatistics >();
+}
+
+Q_CONSTRUCTOR_FUNCTION( qskRegisterFrameStatistics )
+
+namespace
+{
+    class RecorderMap
+    {
+      public:
+        QMutex mutex;
+        QHash< const QQuickWindow*, QskFrameRecorder* > recorders;
+    };
+}
+
+Q_GLOBAL_STATIC( RecorderMap, qskRecorderMap )
+
+/*
+    Looking up the recorder of a window is done under a mutex. As
+    recording is usually off, we avoid this by checking a counter first.
+ */
+static std::atomic< int > qskRecorderCount { 0 };
+
+// the recorder of the window, that is synchronized by the current thread
+static thread_local QskFrameRecorder* qskSyncRecorder = nullptr;
+
+QskFrameStatistics::QskFrameStatistics() noexcept
+    : m_frame( 0 )
+{
+    for ( auto& value : m_values )
+        value = 0;
+}
+
+void QskFrameStatistics::setFrame( quint64 frame ) noexcept
+{
+    m_frame = frame;
+}
+
+void QskFrameStatistics::setValue( Counter counter, qint64 value ) noexcept
+{
+    m_values[ counter ] = value;
+}
+
+void QskFrameStatistics::count(
+    const QQuickWindow* window, Counter counter, qint64 value )
+{
+    if ( qskRecorderCount.load( std::memory_order_relaxed ) == 0 || window == nullptr )
+        return;
+
+    if ( qskSyncRecorder && qskSyncRecorder->m_data->window == window )
+    {
+        // no need for locking, as the GUI thread is blocked while synchronizing
+        qskSyncRecorder->count( counter, value );
+        return;
+    }
+
+    QMutexLocker locker( &qskRecorderMap->mutex );
+
+    if ( auto recorder = qskRecorderMap->recorders.value( window ) )
+        recorder->count( counter, value );
+}
+
+void QskFrameStatistics::count( Counter counter, qint64 value )
+{
+    if ( qskSyncRecorder )
+        qskSyncRecorder->count( counter, value );
+}
+
+bool QskFrameStatistics::isRecording( const QQuickWindow* window )
+{
+    if ( qskRecorderCount.load( std::memory_order_relaxed ) == 0 || window == nullptr )
+        return false;
+
+    QMutexLocker locker( &qskRecorderMap->mutex );
+    return qskRecorderMap->recorders.contains( window );
+}
+
+class QskFrameRecorder::PrivateData
+{
+  public:
+    QQuickWindow* window;
+
+    QMetaObject::Connection connections[ 2 ];
+
+    std::atomic< qint64 > counters[ QskFrameStatistics::CounterCount ];
+    QElapsedTimer syncTimer;
+
+    quint64 frame = 0;
+
+    // the ring buffer, protected by the mutex
+    mutable QMutex mutex;
+    QVector< QskFrameStatistics > frames;
+    int capacity = 120;
+    int next = 0;
+};
+
+QskFrameRecorder::QskFrameRecorder( QQuickWindow* window )
+    : m_data( new PrivateData() )
+{
+    m_data->window = window;
+
+    for ( auto& counter : m_data->counters )
+        counter = 0;
+
+    /*
+        The signals are emitted from the scene graph thread,
+        while the GUI thread is blocked.
+     */
+    m_data->connections[ 0 ] = QObject::connect(
+        window, &QQuickWindow::beforeSynchronizing,
+        [ this ] { beginSync(); } );
+
+    m_data->connections[ 1 ] = QObject::connect(
+        window, &QQuickWindow::afterSynchronizing,
+        [ this ] { endSync(); } );
+
+    QMutexLocker locker( &qskRecorderMap->mutex );
+
+    qskRecorderMap->recorders.insert( window, this );
+    qskRecorderCount++;
+}
+
+QskFrameRecorder::~QskFrameRecorder()
+{
+    QObject::disconnect( m_data->connections[ 0 ] );
+    QObject::disconnect( m_data->connections[ 1 ] );
+
+    if ( qskRecorderMap )
+    {
+        QMutexLocker locker( &qskRecorderMap->mutex );
+
+        qskRecorderMap->recorders.remove( m_data->window );
+        qskRecorderCount--;
+    }
+}
+
+void QskFrameRecorder::setCapacity( int capacity )
+{
+    capacity = qMax( capacity, 1 );
+
+    const auto frames = this->frames();
+
+    QMutexLocker locker( &m_data->mutex );
+
+    m_data->capacity = capacity;
+
+    m_data->frames = frames.mid( qMax( frames.count() - capacity, 0 ) );
+    m_data->next = m_data->frames.count() % capacity;
+}
+
+int QskFrameRecorder::capacity() const
+{
+    QMutexLocker locker( &m_data->mutex );
+    return m_data->capacity;
+}
+
+QVector< QskFrameStatistics > QskFrameRecorder::frames() const
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    const auto& frames = m_data->frames;
+
+    if ( frames.count() < m_data->capacity )
+        return frames;
+
+    // the buffer is full: the oldest frame is the next one to be replaced
+    return frames.mid( m_data->next ) + frames.mid( 0, m_data->next );
+}
+
+void QskFrameRecorder::clear()
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    m_data->frames.clear();
+    m_data->next = 0;
+}
+
+bool QskFrameRecorder::dump( const QString& fileName ) const
+{
+    QFile file( fileName );
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Text ) )
+        return false;
+
+    const auto metaEnum = QMetaEnum::fromType< QskFrameStatistics::Counter >();
+
+    QTextStream stream( &file );
+
+    stream << "frame";
+    for ( int i = 0; i < QskFrameStatistics::CounterCount; i++ )
+        stream << ',' << metaEnum.valueToKey( i );
+    stream << '\n';
+
+    const auto frames = this->frames();
+    for ( const auto& frame : frames )
+    {
+        stream << frame.frame();
+
+        for ( int i = 0; i < QskFrameStatistics::CounterCount; i++ )
+            stream << ',' << frame.value( static_cast< QskFrameStatistics::Counter >( i ) );
+
+        stream << '\n';
+    }
+
+    stream.flush();
+    return file.error() == QFileDevice::NoError;
+}
+
+inline void QskFrameRecorder::count(
+    QskFrameStatistics::Counter counter, qint64 value )
+{
+    m_data->counters[ counter ].fetch_add( value, std::memory_order_relaxed );
+}
+
+void QskFrameRecorder::beginSync()
+{
+    qskSyncRecorder = this;
+    m_data->syncTimer.start();
+}
+
+void QskFrameRecorder::endSync()
+{
+    qskSyncRecorder = nullptr;
+
+    m_data->counters[ QskFrameStatistics::SyncTime ] = m_data->syncTimer.nsecsElapsed();
+
+    QskFrameStatistics statistics;
+    statistics.setFrame( m_data->frame++ );
+
+    for ( int i = 0; i < QskFrameStatistics::CounterCount; i++ )
+    {
+        const auto counter = static_cast< QskFrameStatistics::Counter >( i );
+        statistics.setValue( counter, m_data->counters[ i ].exchange( 0 ) );
+    }
+
+    QMutexLocker locker( &m_data->mutex );
+
+    auto& frames = m_data->frames;
+
+    if ( frames.count() < m_data->capacity )
+        frames += statistics;
+    else
+        frames[ m_data->next ] = statistics;
+
+    m_data->next = ( m_data->next + 1 ) % m_data->capacity;
+}
+
+#ifndef QT_NO_DEBUG_STREAM
+
+#include <qdebug.h>
+
+QDebug operator<<( QDebug debug, const QskFrameStatistics& statistics )
+{
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << "QskFrameStatistics" << '(';
+    debug << "frame: " << statistics.frame()
+          << ", polish: " << statistics.polishTime()
+          << ", sync: " << statistics.syncTime()
+          << ", updatePaintNode: " << statistics.updatePaintNodeCalls()
+          << ", nodes: +" << statistics.createdNodes()
+          << "/-" << statistics.destroyedNodes()
+          << ", geometry: " << statistics.geometryBytes()
+          << ", textures: " << statistics.paintedTextures()
+          << ", animators: " << statistics.advancedAnimators()
+          << ", sizeHints: " << statistics.calculatedSizeHints()
+          << "/" << statistics.cachedSizeHints();
+    debug << ')';
+
+    return debug;
+}
+
+#endif
+
+#include "moc_QskFrameStatistics.cpp"
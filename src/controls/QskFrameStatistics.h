@@ -0,0 +1,207 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_FRAME_STATISTICS_H
+#define QSK_FRAME_STATISTICS_H
+
+#include "QskGlobal.h"
+
+#include <qmetatype.h>
+#include <qvector.h>
+
+#include <memory>
+
+class QQuickWindow;
+class QString;
+
+/*
+    The statistics of one frame of a window. Times are in nanoseconds.
+
+    A frame is completed, when the scene graph has been synchronized.
+    Polishing happens before, so polish and sync times, as well as the
+    counters, that are increased during polishing and synchronizing,
+    belong to the same frame.
+ */
+class QSK_EXPORT QskFrameStatistics
+{
+    Q_GADGET
+
+    Q_PROPERTY( quint64 frame READ frame )
+
+    Q_PROPERTY( qint64 polishTime READ polishTime )
+    Q_PROPERTY( qint64 syncTime READ syncTime )
+
+    Q_PROPERTY( qint64 updatePaintNodeCalls READ updatePaintNodeCalls )
+    Q_PROPERTY( qint64 createdNodes READ createdNodes )
+    Q_PROPERTY( qint64 destroyedNodes READ destroyedNodes )
+    Q_PROPERTY( qint64 geometryBytes READ geometryBytes )
+    Q_PROPERTY( qint64 paintedTextures READ paintedTextures )
+    Q_PROPERTY( qint64 advancedAnimators READ advancedAnimators )
+
+    Q_PROPERTY( qint64 calculatedSizeHints READ calculatedSizeHints )
+    Q_PROPERTY( qint64 cachedSizeHints READ cachedSizeHints )
+
+  public:
+    enum Counter
+    {
+        PolishTime,
+        SyncTime,
+
+        UpdatePaintNodeCalls,
+        CreatedNodes,
+        DestroyedNodes,
+        GeometryBytes,
+        PaintedTextures,
+        AdvancedAnimators,
+
+        CalculatedSizeHints,
+        CachedSizeHints,
+
+        CounterCount
+    };
+    Q_ENUM( Counter )
+
+    QskFrameStatistics() noexcept;
+
+    quint64 frame() const noexcept;
+    void setFrame( quint64 ) noexcept;
+
+    qint64 value( Counter ) const noexcept;
+    void setValue( Counter, qint64 ) noexcept;
+
+    qint64 polishTime() const noexcept;
+    qint64 syncTime() const noexcept;
+
+    qint64 updatePaintNodeCalls() const noexcept;
+    qint64 createdNodes() const noexcept;
+    qint64 destroyedNodes() const noexcept;
+    qint64 geometryBytes() const noexcept;
+    qint64 paintedTextures() const noexcept;
+    qint64 advancedAnimators() const noexcept;
+
+    qint64 calculatedSizeHints() const noexcept;
+    qint64 cachedSizeHints() const noexcept;
+
+    /*
+        Increasing a counter of the window, when it is recording.
+        Without window the counter of the window is increased, that is
+        synchronized by the calling thread - what is the situation,
+        when being inside of updatePaintNode().
+     */
+    static void count( const QQuickWindow*, Counter, qint64 value = 1 );
+    static void count( Counter, qint64 value = 1 );
+
+    static bool isRecording( const QQuickWindow* );
+
+  private:
+    quint64 m_frame;
+    qint64 m_values[ CounterCount ];
+};
+
+inline quint64 QskFrameStatistics::frame() const noexcept
+{
+    return m_frame;
+}
+
+inline qint64 QskFrameStatistics::value( Counter counter ) const noexcept
+{
+    return m_values[ counter ];
+}
+
+inline qint64 QskFrameStatistics::polishTime() const noexcept
+{
+    return m_values[ PolishTime ];
+}
+
+inline qint64 QskFrameStatistics::syncTime() const noexcept
+{
+    return m_values[ SyncTime ];
+}
+
+inline qint64 QskFrameStatistics::updatePaintNodeCalls() const noexcept
+{
+    return m_values[ UpdatePaintNodeCalls ];
+}
+
+inline qint64 QskFrameStatistics::createdNodes() const noexcept
+{
+    return m_values[ CreatedNodes ];
+}
+
+inline qint64 QskFrameStatistics::destroyedNodes() const noexcept
+{
+    return m_values[ DestroyedNodes ];
+}
+
+inline qint64 QskFrameStatistics::geometryBytes() const noexcept
+{
+    return m_values[ GeometryBytes ];
+}
+
+inline qint64 QskFrameStatistics::paintedTextures() const noexcept
+{
+    return m_values[ PaintedTextures ];
+}
+
+inline qint64 QskFrameStatistics::advancedAnimators() const noexcept
+{
+    return m_values[ AdvancedAnimators ];
+}
+
+inline qint64 QskFrameStatistics::calculatedSizeHints() const noexcept
+{
+    return m_values[ CalculatedSizeHints ];
+}
+
+inline qint64 QskFrameStatistics::cachedSizeHints() const noexcept
+{
+    return m_values[ CachedSizeHints ];
+}
+
+/*
+    Records the statistics of the last frames of a window
+    in a ring buffer.
+ */
+class QSK_EXPORT QskFrameRecorder
+{
+  public:
+    QskFrameRecorder( QQuickWindow* );
+    ~QskFrameRecorder();
+
+    void setCapacity( int );
+    int capacity() const;
+
+    // the oldest frame first
+    QVector< QskFrameStatistics > frames() const;
+    void clear();
+
+    // writing the frames as CSV
+    bool dump( const QString& fileName ) const;
+
+  private:
+    Q_DISABLE_COPY( QskFrameRecorder )
+
+    friend class QskFrameStatistics;
+
+    void count( QskFrameStatistics::Counter, qint64 value );
+
+    void beginSync();
+    void endSync();
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#ifndef QT_NO_DEBUG_STREAM
+
+class QDebug;
+QSK_EXPORT QDebug operator<<( QDebug, const QskFrameStatistics& );
+
+#endif
+
+Q_DECLARE_TYPEINFO( QskFrameStatistics, Q_MOVABLE_TYPE );
+Q_DECLARE_METATYPE( QskFrameStatistics )
+
+#endif
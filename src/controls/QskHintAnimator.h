@@ -51,6 +51,8 @@ class QSK_EXPORT QskHintAnimatorTable
     const QskHintAnimator* animator( QskAspect ) const;
     QVariant currentValue( QskAspect ) const;
 
+    bool isEmpty() const;
+
     bool cleanup();
 
   private:
@@ -60,6 +62,11 @@ class QSK_EXPORT QskHintAnimatorTable
     PrivateData* m_data;
 };
 
+inline bool QskHintAnimatorTable::isEmpty() const
+{
+    return m_data == nullptr;
+}
+
 inline QskAspect QskHintAnimator::aspect() const
 {
     return m_aspect;
@@ -13,28 +13,285 @@
 
 #include <qmath.h>
 
+#include <vector>
+
 QSK_SUBCONTROL( QskListView, Cell )
 QSK_SUBCONTROL( QskListView, Text )
 
 QSK_STATE( QskListView, Selected, QskAspect::FirstUserState )
 
+namespace
+{
+    /*
+        A Fenwick tree of the row heights. Building it is O(n),
+        updating a height and all lookups are O(log n).
+     */
+    class RowIndex
+    {
+      public:
+        void build( const QskListView* listView )
+        {
+            const int count = listView->rowCount();
+
+            m_heights.resize( count );
+            m_tree.assign( count + 1, 0.0 );
+
+            m_total = 0.0;
+
+            for ( int i = 1; i <= count; i++ )
+            {
+                const qreal h = listView->rowHeightAt( i - 1 );
+
+                m_heights[ i - 1 ] = h;
+                m_total += h;
+
+                m_tree[ i ] += h;
+
+                const int parent = i + ( i & -i );
+                if ( parent <= count )
+                    m_tree[ parent ] += m_tree[ i ];
+            }
+
+            m_mask = 1;
+            while ( ( m_mask << 1 ) <= count )
+                m_mask <<= 1;
+
+            m_isValid = true;
+        }
+
+        inline void invalidate()
+        {
+            m_isValid = false;
+        }
+
+        inline bool isValid( int rowCount ) const
+        {
+            return m_isValid && ( rowCount == count() );
+        }
+
+        inline int count() const
+        {
+            return static_cast< int >( m_heights.size() );
+        }
+
+        inline qreal totalHeight() const
+        {
+            return m_total;
+        }
+
+        void setHeight( int row, qreal height )
+        {
+            const qreal delta = height - m_heights[ row ];
+            if ( delta == 0.0 )
+                return;
+
+            m_heights[ row ] = height;
+            m_total += delta;
+
+            for ( int i = row + 1; i <= count(); i += ( i & -i ) )
+                m_tree[ i ] += delta;
+        }
+
+        qreal offset( int row ) const
+        {
+            // the sum of the heights of all rows before row
+
+            if ( row >= count() )
+                return m_total;
+
+            qreal sum = 0.0;
+            for ( int i = row; i > 0; i -= ( i & -i ) )
+                sum += m_tree[ i ];
+
+            return sum;
+        }
+
+        int rowAt( qreal y ) const
+        {
+            if ( y <= 0.0 )
+                return 0;
+
+            if ( y >= m_total )
+                return count();
+
+            // the number of rows, that end before or at y
+            int pos = 0;
+
+            for ( int step = m_mask; step > 0; step >>= 1 )
+            {
+                const int next = pos + step;
+
+                if ( next <= count() && m_tree[ next ] <= y )
+                {
+                    pos = next;
+                    y -= m_tree[ next ];
+                }
+            }
+
+            return pos;
+        }
+
+      private:
+        std::vector< qreal > m_heights;
+        std::vector< qreal > m_tree; // 1-based
+        qreal m_total = 0.0;
+        int m_mask = 0;
+        bool m_isValid = false;
+    };
+
+    class CellChange
+    {
+      public:
+        enum Type
+        {
+            Modified,
+            Inserted,
+            Removed,
+            Moved
+        };
+
+        Type type;
+
+        int row;
+        int count;
+
+        int col; // Modified
+        int columnCount; // Modified
+        int to; // Moved
+    };
+
+    /*
+        The notifications since the cells have been invalidated. The log
+        has a limited size as a recent revision is usually requested only.
+     */
+    class ChangeLog
+    {
+      public:
+        inline quint64 revision() const
+        {
+            return m_revision;
+        }
+
+        void invalidate()
+        {
+            m_changes.clear();
+            m_revision++;
+        }
+
+        void append( const CellChange& change )
+        {
+            if ( m_changes.size() >= 256 )
+                m_changes.erase( m_changes.begin(), m_changes.begin() + 128 );
+
+            m_changes.push_back( change );
+            m_revision++;
+        }
+
+        int previousRow( int row, int col, quint64 revision ) const
+        {
+            const auto count = m_changes.size();
+
+            if ( revision > m_revision || m_revision - revision > count )
+                return -1;
+
+            // undoing the changes since revision, starting with the latest
+
+            for ( auto i = m_revision - revision; i > 0; i-- )
+            {
+                const auto& change = m_changes[ count - i ];
+
+                switch ( change.type )
+                {
+                    case CellChange::Modified:
+                    {
+                        if ( row >= change.row && row < change.row + change.count
+                            && col >= change.col && col < change.col + change.columnCount )
+                        {
+                            return -1;
+                        }
+
+                        break;
+                    }
+                    case CellChange::Inserted:
+                    {
+                        if ( row >= change.row )
+                        {
+                            if ( row < change.row + change.count )
+                                return -1;
+
+                            row -= change.count;
+                        }
+
+                        break;
+                    }
+                    case CellChange::Removed:
+                    {
+                        if ( row >= change.row )
+                            row += change.count;
+
+                        break;
+                    }
+                    case CellChange::Moved:
+                    {
+                        if ( row >= change.to && row < change.to + change.count )
+                        {
+                            row = change.row + ( row - change.to );
+                        }
+                        else
+                        {
+                            if ( row >= change.to )
+                                row -= change.count;
+
+                            if ( row >= change.row )
+                                row += change.count;
+                        }
+
+                        break;
+                    }
+                }
+            }
+
+            return row;
+        }
+
+      private:
+        std::vector< CellChange > m_changes;
+        quint64 m_revision = 0;
+    };
+}
+
 class QskListView::PrivateData
 {
   public:
     PrivateData()
         : preferredWidthFromColumns( false )
         , alternatingRowColors( false )
+        , variableRowHeights( false )
+        , incrementalUpdates( false )
         , selectionMode( QskListView::SingleSelection )
         , selectedRow( -1 )
     {
     }
 
+    inline const RowIndex& rowIndex( const QskListView* listView ) const
+    {
+        if ( !index.isValid( listView->rowCount() ) )
+            index.build( listView );
+
+        return index;
+    }
+
     QskTextOptions textOptions;
     bool preferredWidthFromColumns : 1;
     bool alternatingRowColors : 1;
+    bool variableRowHeights : 1;
+    bool incrementalUpdates : 1;
     SelectionMode selectionMode : 4;
 
     int selectedRow;
+
+    mutable RowIndex index;
+    ChangeLog changeLog;
 };
 
 QskListView::QskListView( QQuickItem* parent )
@@ -95,6 +352,174 @@ QskTextOptions QskListView::textOptions() const
     return m_data->textOptions;
 }
 
+void QskListView::setVariableRowHeights( bool on )
+{
+    if ( on != m_data->variableRowHeights )
+    {
+        m_data->variableRowHeights = on;
+        updateScrollableSize();
+        update();
+
+        Q_EMIT variableRowHeightsChanged( on );
+    }
+}
+
+bool QskListView::hasVariableRowHeights() const
+{
+    return m_data->variableRowHeights;
+}
+
+void QskListView::setIncrementalUpdates( bool on )
+{
+    if ( on != m_data->incrementalUpdates )
+    {
+        m_data->incrementalUpdates = on;
+        invalidateCells();
+
+        Q_EMIT incrementalUpdatesChanged( on );
+    }
+}
+
+bool QskListView::hasIncrementalUpdates() const
+{
+    return m_data->incrementalUpdates;
+}
+
+qreal QskListView::rowHeightAt( int row ) const
+{
+    Q_UNUSED( row )
+    return rowHeight();
+}
+
+void QskListView::updateRowHeight( int row )
+{
+    if ( !m_data->variableRowHeights )
+        return;
+
+    auto& index = m_data->index;
+
+    if ( !index.isValid( rowCount() ) || row < 0 || row >= rowCount() )
+        return;
+
+    index.setHeight( row, rowHeightAt( row ) );
+
+    // the cells of the row have a different size now
+    cellsChanged( row, 0, 1, columnCount() );
+
+    adjustScrollableSize();
+}
+
+void QskListView::cellsChanged( int row, int col, int rowCount, int columnCount )
+{
+    if ( rowCount <= 0 || columnCount <= 0 )
+        return;
+
+    CellChange change;
+    change.type = CellChange::Modified;
+    change.row = row;
+    change.count = rowCount;
+    change.col = col;
+    change.columnCount = columnCount;
+    change.to = -1;
+
+    m_data->changeLog.append( change );
+    update();
+}
+
+void QskListView::rowsInserted( int row, int count )
+{
+    if ( count <= 0 )
+        return;
+
+    CellChange change;
+    change.type = CellChange::Inserted;
+    change.row = row;
+    change.count = count;
+    change.col = change.columnCount = 0;
+    change.to = -1;
+
+    m_data->changeLog.append( change );
+    m_data->index.invalidate();
+
+    adjustScrollableSize();
+    update();
+}
+
+void QskListView::rowsRemoved( int row, int count )
+{
+    if ( count <= 0 )
+        return;
+
+    CellChange change;
+    change.type = CellChange::Removed;
+    change.row = row;
+    change.count = count;
+    change.col = change.columnCount = 0;
+    change.to = -1;
+
+    m_data->changeLog.append( change );
+    m_data->index.invalidate();
+
+    adjustScrollableSize();
+    update();
+}
+
+void QskListView::rowsMoved( int row, int count, int to )
+{
+    if ( count <= 0 || row == to )
+        return;
+
+    CellChange change;
+    change.type = CellChange::Moved;
+    change.row = row;
+    change.count = count;
+    change.col = change.columnCount = 0;
+    change.to = to;
+
+    m_data->changeLog.append( change );
+
+    if ( m_data->variableRowHeights )
+    {
+        // the total height does not change
+        m_data->index.invalidate();
+    }
+
+    update();
+}
+
+void QskListView::invalidateCells()
+{
+    m_data->changeLog.invalidate();
+    update();
+}
+
+quint64 QskListView::cellsRevision() const
+{
+    return m_data->changeLog.revision();
+}
+
+int QskListView::previousRow( int row, int col, quint64 revision ) const
+{
+    return m_data->changeLog.previousRow( row, col, revision );
+}
+
+qreal QskListView::rowOffset( int row ) const
+{
+    if ( m_data->variableRowHeights )
+        return m_data->rowIndex( this ).offset( qMax( row, 0 ) );
+
+    return row * rowHeight();
+}
+
+int QskListView::rowAt( qreal y ) const
+{
+    if ( m_data->variableRowHeights )
+        return m_data->rowIndex( this ).rowAt( y );
+
+    const auto h = rowHeight();
+    return ( h > 0.0 ) ? qFloor( y / h ) : 0;
+}
+
 void QskListView::setSelectedRow( int row )
 {
     if ( row < 0 )
@@ -116,6 +541,13 @@ void QskListView::setSelectedRow( int row )
 
     if ( row != m_data->selectedRow )
     {
+        // the cells of both rows are rendered with different states
+        if ( m_data->selectedRow >= 0 )
+            cellsChanged( m_data->selectedRow, 0, 1, columnCount() );
+
+        if ( row >= 0 )
+            cellsChanged( row, 0, 1, columnCount() );
+
         m_data->selectedRow = row;
         Q_EMIT selectedRowChanged( row );
 
@@ -216,7 +648,9 @@ void QskListView::keyPressEvent( QKeyEvent* event )
     {
         auto pos = scrollPos();
 
-        const qreal rowPos = row * rowHeight();
+        const qreal rowPos = rowOffset( row );
+        const qreal rowEnd = rowOffset( row + 1 );
+
         if ( rowPos < scrollPos().y() )
         {
             pos.setY( rowPos );
@@ -226,9 +660,9 @@ void QskListView::keyPressEvent( QKeyEvent* event )
             const QRectF vr = viewContentsRect();
 
             const double scrolledBottom = scrollPos().y() + vr.height();
-            if ( rowPos + rowHeight() > scrolledBottom )
+            if ( rowEnd > scrolledBottom )
             {
-                const double y = rowPos + rowHeight() - vr.height();
+                const double y = rowEnd - vr.height();
                 pos.setY( y );
             }
         }
@@ -255,7 +689,7 @@ void QskListView::mousePressEvent( QMouseEvent* event )
         const QRectF vr = viewContentsRect();
         if ( vr.contains( event->pos() ) )
         {
-            const int row = ( event->pos().y() - vr.top() + scrollPos().y() ) / rowHeight();
+            const int row = rowAt( event->pos().y() - vr.top() + scrollPos().y() );
             if ( row >= 0 && row < rowCount() )
                 setSelectedRow( row );
 
@@ -273,19 +707,27 @@ void QskListView::mouseReleaseEvent( QMouseEvent* event )
 
 #ifndef QT_NO_WHEELEVENT
 
-static qreal qskAlignedToRows( const qreal y0, qreal dy,
-    qreal rowHeight, qreal viewHeight )
+static qreal qskAlignedToRows( const QskListView* listView,
+    const qreal y0, qreal dy, qreal viewHeight )
 {
     qreal y = y0 - dy;
 
     if ( dy > 0 )
     {
-        y = qFloor( y / rowHeight ) * rowHeight;
+        y = listView->rowOffset( listView->rowAt( y ) );
     }
     else
     {
         y += viewHeight;
-        y = qCeil( y / rowHeight ) * rowHeight;
+
+        const int row = listView->rowAt( y );
+
+        const qreal rowPos = listView->rowOffset( row );
+        if ( rowPos < y )
+            y = listView->rowOffset( row + 1 );
+        else
+            y = rowPos;
+
         y -= viewHeight;
     }
 
@@ -332,7 +774,7 @@ QPointF QskListView::scrollOffset( const QWheelEvent* event ) const
         dy *= offset.y(); // multiplied by the wheelsteps
 
         // aligning rows that enter the view
-        dy = qskAlignedToRows( y0, dy, rowHeight, viewHeight );
+        dy = qskAlignedToRows( this, y0, dy, viewHeight );
 
         offset.setY( y0 - dy );
     }
@@ -344,9 +786,43 @@ QPointF QskListView::scrollOffset( const QWheelEvent* event ) const
 
 #endif
 
+void QskListView::changeEvent( QEvent* event )
+{
+    switch ( static_cast< int >( event->type() ) )
+    {
+        case QEvent::FontChange:
+        case QEvent::LocaleChange:
+        {
+            // the text of the cells might depend on font and locale
+            invalidateCells();
+            break;
+        }
+    }
+
+    Inherited::changeEvent( event );
+}
+
 void QskListView::updateScrollableSize()
 {
-    const double h = rowCount() * rowHeight();
+    // the model might have been reset
+    m_data->index.invalidate();
+    invalidateCells();
+
+    adjustScrollableSize();
+}
+
+void QskListView::adjustScrollableSize()
+{
+    double h;
+
+    if ( m_data->variableRowHeights )
+    {
+        h = m_data->rowIndex( this ).totalHeight();
+    }
+    else
+    {
+        h = rowCount() * rowHeight();
+    }
 
     qreal w = 0.0;
     for ( int col = 0; col < columnCount(); col++ )
@@ -28,6 +28,12 @@ class QSK_EXPORT QskListView : public QskScrollView
     Q_PROPERTY( bool preferredWidthFromColumns READ preferredWidthFromColumns
         WRITE setPreferredWidthFromColumns NOTIFY preferredWidthFromColumnsChanged() )
 
+    Q_PROPERTY( bool variableRowHeights READ hasVariableRowHeights
+        WRITE setVariableRowHeights NOTIFY variableRowHeightsChanged FINAL )
+
+    Q_PROPERTY( bool incrementalUpdates READ hasIncrementalUpdates
+        WRITE setIncrementalUpdates NOTIFY incrementalUpdatesChanged FINAL )
+
     using Inherited = QskScrollView;
 
   public:
@@ -54,6 +60,24 @@ class QSK_EXPORT QskListView : public QskScrollView
     void setSelectionMode( SelectionMode );
     SelectionMode selectionMode() const;
 
+    /*
+        With variable row heights the heights are retrieved from
+        rowHeightAt() and kept in an index, so that the offset of a row
+        and the row at an offset can be found in O(log n).
+        Otherwise all rows have the height of rowHeight().
+     */
+    void setVariableRowHeights( bool );
+    bool hasVariableRowHeights() const;
+
+    /*
+        By default all visible cells are rendered again with every update.
+        With incremental updates the cells are only rendered again, when
+        being notified about changes of the model - see cellsChanged().
+        A subclass, that enables it, has to send the notifications.
+     */
+    void setIncrementalUpdates( bool );
+    bool hasIncrementalUpdates() const;
+
     void setTextOptions( const QskTextOptions& textOptions );
     QskTextOptions textOptions() const;
 
@@ -65,8 +89,43 @@ class QSK_EXPORT QskListView : public QskScrollView
     virtual qreal columnWidth( int col ) const = 0;
     virtual qreal rowHeight() const = 0;
 
+    // used for variable row heights only, the default implementation returns rowHeight()
+    virtual qreal rowHeightAt( int row ) const;
+
+    // has to be called, when the height of a row has changed
+    void updateRowHeight( int row );
+
+    // the position of a row, relative to the scrollable contents
+    qreal rowOffset( int row ) const;
+
+    // the row at a position, relative to the scrollable contents
+    int rowAt( qreal y ) const;
+
     Q_INVOKABLE virtual QVariant valueAt( int row, int col ) const = 0;
 
+    /*
+        With incremental updates the cells are only rendered again, when being
+        notified about changes of the model. Modifications, that can't be
+        expressed by the notifications below, have to be propagated by
+        invalidateCells(), what is also done by updateScrollableSize().
+     */
+    void cellsChanged( int row, int col, int rowCount = 1, int columnCount = 1 );
+    void rowsInserted( int row, int count );
+    void rowsRemoved( int row, int count );
+
+    // the moved rows start at row "to" afterwards
+    void rowsMoved( int row, int count, int to );
+
+    void invalidateCells();
+
+    /*
+        The revision is increased with every notification. previousRow() returns
+        the row, that has been at the position of row in an older revision - or -1,
+        when the cell has been modified or inserted since then.
+     */
+    quint64 cellsRevision() const;
+    int previousRow( int row, int col, quint64 revision ) const;
+
 #if 1
     virtual QskColorFilter graphicFilterAt( int row, int col ) const;
 #endif
@@ -80,9 +139,13 @@ class QSK_EXPORT QskListView : public QskScrollView
     void selectionModeChanged();
     void alternatingRowColorsChanged();
     void preferredWidthFromColumnsChanged();
+    void variableRowHeightsChanged( bool );
+    void incrementalUpdatesChanged( bool );
     void textOptionsChanged();
 
   protected:
+    void changeEvent( QEvent* ) override;
+
     void keyPressEvent( QKeyEvent* ) override;
     void keyReleaseEvent( QKeyEvent* ) override;
 
@@ -98,6 +161,8 @@ class QSK_EXPORT QskListView : public QskScrollView
     void componentComplete() override;
 
   private:
+    void adjustScrollableSize();
+
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
@@ -9,18 +9,62 @@
 #include "QskColorFilter.h"
 #include "QskGraphic.h"
 #include "QskSGNode.h"
+#include "QskSkin.h"
+#include "QskSkinHintTable.h"
 #include "QskSkinStateChanger.h"
 
 #include <qmath.h>
 #include <qsgnode.h>
 #include <qsgsimplerectnode.h>
 #include <qtransform.h>
+#include <qvector.h>
+
+#include <vector>
+
+namespace
+{
+    // the attributes of the cell nodes, that do not depend on the model
+    class CellAttributes
+    {
+      public:
+        CellAttributes() = default;
+
+        CellAttributes( const QskListView* listView )
+            : states( listView->skinStates() )
+            , localGeneration( listView->hintTable().generation() )
+            , isTransitioning( listView->hasRunningTransitions() )
+        {
+            if ( auto skin = listView->effectiveSkin() )
+                skinGeneration = skin->hintTable().generation();
+
+            if ( !listView->hasVariableRowHeights() )
+                rowHeight = listView->rowHeight();
+        }
+
+        inline bool operator==( const CellAttributes& other ) const
+        {
+            // during transitions the effective hints are changing
+            return !isTransitioning && !other.isTransitioning
+                && ( states == other.states )
+                && ( localGeneration == other.localGeneration )
+                && ( skinGeneration == other.skinGeneration )
+                && ( rowHeight == other.rowHeight );
+        }
+
+        QskAspect::States states;
+
+        quint32 localGeneration = 0;
+        quint32 skinGeneration = 0;
+        bool isTransitioning = true;
+
+        qreal rowHeight = -1.0; // uniform row heights only
+    };
+}
 
 class QskListViewNode final : public QSGTransformNode
 {
   public:
-    inline QskListViewNode( int columnCount )
-        : m_columnCount( columnCount )
+    inline QskListViewNode()
     {
         m_backgroundNode.setFlag( QSGNode::OwnedByParent, false );
         appendChildNode( &m_backgroundNode );
@@ -39,10 +83,20 @@ class QskListViewNode final : public QSGTransformNode
         return &m_foregroundNode;
     }
 
-    inline void resetRows( int rowMin, int rowMax )
+    inline void resetCells( const QskListView* listView,
+        int rowMin, int rowMax, int colMin, int colMax,
+        const CellAttributes& attributes )
     {
         m_rowMin = rowMin;
         m_rowMax = rowMax;
+        m_colMin = colMin;
+
+        m_columnWidths.clear();
+        for ( int col = colMin; col <= colMax; col++ )
+            m_columnWidths += listView->columnWidth( col );
+
+        m_revision = listView->cellsRevision();
+        m_attributes = attributes;
     }
 
     inline int rowMin() const
@@ -55,30 +109,59 @@ class QskListViewNode final : public QSGTransformNode
         return m_rowMax;
     }
 
-    inline bool intersects( int rowMin, int rowMax ) const
+    inline int colMin() const
     {
-        return ( rowMin <= m_rowMax ) && ( rowMax >= m_rowMin );
+        return m_colMin;
     }
 
-    inline int nodeCount() const
+    inline int colMax() const
     {
-        return ( m_rowMin >= 0 ) ? ( m_rowMax - m_rowMin + 1 ) * m_columnCount : 0;
+        return m_colMin + m_columnWidths.count() - 1;
     }
 
-    inline int columnCount() const
+    inline int colCount() const
     {
-        return m_columnCount;
+        return m_columnWidths.count();
+    }
+
+    // the width of a column, when the cells have been updated
+    inline qreal columnWidth( int col ) const
+    {
+        return m_columnWidths[ col - m_colMin ];
+    }
+
+    inline quint64 revision() const
+    {
+        return m_revision;
+    }
+
+    inline const CellAttributes& attributes() const
+    {
+        return m_attributes;
+    }
+
+    inline bool hasCells() const
+    {
+        return m_rowMin >= 0;
     }
 
     inline void invalidate()
     {
-        m_rowMin = m_rowMax = -1;
+        m_rowMin = m_rowMax = m_colMin = -1;
+        m_columnWidths.clear();
+
+        m_attributes = CellAttributes();
     }
 
   private:
-    int m_columnCount;
     int m_rowMin = -1;
     int m_rowMax = -1;
+    int m_colMin = -1;
+
+    QVector< qreal > m_columnWidths;
+
+    quint64 m_revision = 0;
+    CellAttributes m_attributes;
 
     QSGNode m_backgroundNode;
     QSGNode m_foregroundNode;
@@ -98,7 +181,7 @@ QSGNode* QskListViewSkinlet::updateContentsNode(
 
     auto listViewNode = static_cast< QskListViewNode* >( node );
     if ( listViewNode == nullptr )
-        listViewNode = new QskListViewNode( listView->columnCount() );
+        listViewNode = new QskListViewNode();
 
     QTransform transform;
     transform.translate( -listView->scrollPos().x(), -listView->scrollPos().y() );
@@ -115,13 +198,12 @@ void QskListViewSkinlet::updateBackgroundNodes(
 {
     QSGNode* backgroundNode = listViewNode->backgroundNode();
 
-    const qreal cellHeight = listView->rowHeight();
     const QRectF viewRect = listView->viewContentsRect();
 
     const QPointF scrolledPos = listView->scrollPos();
-    const int rowMin = qFloor( scrolledPos.y() / cellHeight );
+    const int rowMin = qMax( listView->rowAt( scrolledPos.y() ), 0 );
 
-    int rowMax = qCeil( ( scrolledPos.y() + viewRect.height() ) / cellHeight );
+    int rowMax = listView->rowAt( scrolledPos.y() + viewRect.height() );
     if ( rowMax >= listView->rowCount() )
         rowMax = listView->rowCount() - 1;
 
@@ -139,7 +221,7 @@ void QskListViewSkinlet::updateBackgroundNodes(
             could be used for the alternate color TODO ...
          */
 #endif
-        const auto color = listView->color( QskListView::Cell );
+        const auto color = QColor::fromRgba( listView->rgb( QskListView::Cell ) );
 
         for ( int row = rowMin; row <= rowMax; row++ )
         {
@@ -151,7 +233,10 @@ void QskListViewSkinlet::updateBackgroundNodes(
                     backgroundNode->appendChildNode( rowNode );
                 }
 
-                rowNode->setRect( x0, y0 + row * cellHeight, viewRect.width(), cellHeight );
+                const qreal y = listView->rowOffset( row );
+                const qreal h = listView->rowOffset( row + 1 ) - y;
+
+                rowNode->setRect( x0, y0 + y, viewRect.width(), h );
                 rowNode->setColor( color );
 
                 rowNode = static_cast< QSGSimpleRectNode* >( rowNode->nextSibling() );
@@ -164,7 +249,7 @@ void QskListViewSkinlet::updateBackgroundNodes(
         QskSkinStateChanger stateChanger( listView );
         stateChanger.setStates( listView->skinStates() | QskListView::Selected );
 
-        const QColor color = listView->color( QskListView::Cell );
+        const auto color = QColor::fromRgba( listView->rgb( QskListView::Cell ) );
 
         if ( rowNode == nullptr )
         {
@@ -172,7 +257,10 @@ void QskListViewSkinlet::updateBackgroundNodes(
             backgroundNode->appendChildNode( rowNode );
         }
 
-        rowNode->setRect( x0, y0 + rowSelected * cellHeight, viewRect.width(), cellHeight );
+        const qreal y = listView->rowOffset( rowSelected );
+        const qreal h = listView->rowOffset( rowSelected + 1 ) - y;
+
+        rowNode->setRect( x0, y0 + y, viewRect.width(), h );
         rowNode->setColor( color );
 
         rowNode = static_cast< QSGSimpleRectNode* >( rowNode->nextSibling() );
@@ -194,7 +282,7 @@ void QskListViewSkinlet::updateForegroundNodes(
 
     if ( listView->rowCount() <= 0 || listView->columnCount() <= 0 )
     {
-        parentNode->removeAllChildNodes();
+        QskSGNode::removeAllChildNodesFrom( parentNode, parentNode->firstChild() );
         listViewNode->invalidate();
         return;
     }
@@ -204,152 +292,185 @@ void QskListViewSkinlet::updateForegroundNodes(
     const auto cr = listView->viewContentsRect();
     const auto scrolledPos = listView->scrollPos();
 
-    const int rowMin = qFloor( scrolledPos.y() / listView->rowHeight() );
+    const int rowMin = qBound( 0, listView->rowAt( scrolledPos.y() ),
+        listView->rowCount() - 1 );
 
-    int rowMax = rowMin + qCeil( cr.height() / listView->rowHeight() );
+    int rowMax = listView->rowAt( scrolledPos.y() + cr.height() );
     if ( rowMax >= listView->rowCount() )
         rowMax = listView->rowCount() - 1;
 
-#if 1
-    // should be optimized for visible columns only
-    const int colMin = 0;
-    const int colMax = listView->columnCount() - 1;
-#endif
+    // the visible columns
+    int colMin = -1;
+    int colMax = listView->columnCount() - 1;
+    qreal colOffset = 0.0;
 
-    bool forwards = true;
+    {
+        const qreal x1 = scrolledPos.x();
+        const qreal x2 = x1 + cr.width();
+
+        qreal x = 0.0;
+        for ( int col = 0; col < listView->columnCount(); col++ )
+        {
+            const qreal w = listView->columnWidth( col );
+
+            if ( colMin < 0 && x + w > x1 )
+            {
+                colMin = col;
+                colOffset = x;
+            }
+
+            x += w;
+
+            if ( x >= x2 )
+            {
+                colMax = col;
+                break;
+            }
+        }
+
+        if ( colMin < 0 )
+        {
+            // scrolled beyond the columns
+            colMin = colMax;
+            colOffset = x - listView->columnWidth( colMax );
+        }
+    }
+
+    const int colCount = colMax - colMin + 1;
+    const int rowCount = rowMax - rowMin + 1;
+
+    const CellAttributes attributes( listView );
 
-    if ( listViewNode->intersects( rowMin, rowMax ) )
+    const bool isReusable = listView->hasIncrementalUpdates()
+        && listViewNode->hasCells() && ( listViewNode->attributes() == attributes );
+
+    // taking the nodes of the previous update
+    std::vector< QSGTransformNode* > oldNodes;
+    oldNodes.reserve( parentNode->childCount() );
+
+    for ( auto node = parentNode->firstChild(); node; node = node->nextSibling() )
+    {
+        Q_ASSERT( node->type() == QSGNode::TransformNodeType );
+        oldNodes.push_back( static_cast< QSGTransformNode* >( node ) );
+    }
+
+    parentNode->removeAllChildNodes();
+
+    std::vector< QSGTransformNode* > nodes( rowCount * colCount, nullptr );
+
+    if ( isReusable )
     {
         /*
-            We try to avoid reallcations when scrolling, by reusing
-            the nodes of the cells leaving the viewport for those becoming visible.
+            Cells, that have not been modified since the previous update,
+            are reused as they are. Nodes of inserted or removed rows are shifted
+            without calling updateCellNode() for them again. The same is done for
+            the columns, when scrolling horizontally, as long as their widths
+            have not changed.
          */
+        const auto revision = listViewNode->revision();
 
-        forwards = ( rowMin >= listViewNode->rowMin() );
+        const int oldRowMin = listViewNode->rowMin();
+        const int oldRowMax = listViewNode->rowMax();
 
-        if ( forwards )
+        const int oldColMin = listViewNode->colMin();
+        const int oldColMax = listViewNode->colMax();
+        const int oldColCount = listViewNode->colCount();
+
+        for ( int row = rowMin; row <= rowMax; row++ )
         {
-            // usually scrolling down
-            for ( int row = listViewNode->rowMin(); row < rowMin; row++ )
+            for ( int col = colMin; col <= colMax; col++ )
             {
-                for ( int col = 0; col < listView->columnCount(); col++ )
+                if ( col < oldColMin || col > oldColMax
+                    || listViewNode->columnWidth( col ) != listView->columnWidth( col ) )
                 {
-                    QSGNode* childNode = parentNode->firstChild();
-                    parentNode->removeChildNode( childNode );
-                    parentNode->appendChildNode( childNode );
+                    continue;
                 }
-            }
-        }
-        else
-        {
-            // usually scrolling up
-            for ( int row = rowMax; row < listViewNode->rowMax(); row++ )
-            {
-                for ( int col = 0; col < listView->columnCount(); col++ )
+
+                const int oldRow = listView->previousRow( row, col, revision );
+
+                if ( oldRow >= oldRowMin && oldRow <= oldRowMax )
                 {
-                    QSGNode* childNode = parentNode->lastChild();
-                    parentNode->removeChildNode( childNode );
-                    parentNode->prependChildNode( childNode );
+                    const auto oldIndex =
+                        ( oldRow - oldRowMin ) * oldColCount + ( col - oldColMin );
+
+                    if ( oldIndex < static_cast< int >( oldNodes.size() ) )
+                    {
+                        const auto index = ( row - rowMin ) * colCount + ( col - colMin );
+
+                        nodes[ index ] = oldNodes[ oldIndex ];
+                        oldNodes[ oldIndex ] = nullptr;
+                    }
                 }
             }
         }
     }
 
-    updateVisibleForegroundNodes( listView, listViewNode,
-        rowMin, rowMax, colMin, colMax, margins, forwards );
-
-    // finally putting the nodes into their position
-    auto node = parentNode->firstChild();
-
-    const qreal rowHeight = listView->rowHeight();
-    qreal y = cr.top() + rowMin * rowHeight;
+    /*
+        The remaining cells have to be updated. To avoid reallocations
+        the nodes, that are not needed anymore, are recycled.
+     */
+    auto spareNode = oldNodes.begin();
 
     for ( int row = rowMin; row <= rowMax; row++ )
     {
-        qreal x = cr.left();
+        const qreal h = listView->rowOffset( row + 1 ) - listView->rowOffset( row )
+            - ( margins.top() + margins.bottom() );
 
         for ( int col = colMin; col <= colMax; col++ )
         {
-            Q_ASSERT( node->type() == QSGNode::TransformNodeType );
-            auto transformNode = static_cast< QSGTransformNode* >( node );
+            auto& node = nodes[ ( row - rowMin ) * colCount + ( col - colMin ) ];
+            if ( node )
+                continue;
 
-            QTransform transform;
-            transform.translate( x + margins.left(), y + margins.top() );
+            QSGTransformNode* cellNode = nullptr;
 
-            transformNode->setMatrix( transform );
+            while ( cellNode == nullptr && spareNode != oldNodes.end() )
+                cellNode = *spareNode++;
 
-            node = node->nextSibling();
-            x += listView->columnWidth( col );
-        }
+            const qreal w = listView->columnWidth( col ) - ( margins.left() + margins.right() );
 
-        y += rowHeight;
-    }
+            node = updateForegroundNode( listView, cellNode, row, col, QSizeF( w, h ) );
 
-    listViewNode->resetRows( rowMin, rowMax );
-}
-
-void QskListViewSkinlet::updateVisibleForegroundNodes(
-    const QskListView* listView, QskListViewNode* listViewNode,
-    int rowMin, int rowMax, int colMin, int colMax, const QMarginsF& margins,
-    bool forward ) const
-{
-    auto parentNode = listViewNode->foregroundNode();
-
-    const int rowCount = rowMax - rowMin + 1;
-    const int colCount = colMax - colMin + 1;
-    const int obsoleteNodesCount = listViewNode->nodeCount() - rowCount * colCount;
-
-    if ( forward )
-    {
-        for ( int i = 0; i < obsoleteNodesCount; i++ )
-            delete parentNode->lastChild();
+            if ( node != cellNode )
+                delete cellNode;
+        }
+    }
 
-        auto node = parentNode->firstChild();
+    for ( ; spareNode != oldNodes.end(); ++spareNode )
+        delete *spareNode;
 
-        for ( int row = rowMin; row <= rowMax; row++ )
-        {
-            const qreal h = listView->rowHeight() - ( margins.top() + margins.bottom() );
+    // finally putting the nodes into their position
 
-            for ( int col = 0; col < listView->columnCount(); col++ )
-            {
-                const qreal w = listView->columnWidth( col ) - ( margins.left() + margins.right() );
+    auto node = nodes.cbegin();
 
-                node = updateForegroundNode( listView,
-                    parentNode, static_cast< QSGTransformNode* >( node ),
-                    row, col, QSizeF( w, h ), forward );
+    qreal y = cr.top() + listView->rowOffset( rowMin );
 
-                node = node->nextSibling();
-            }
-        }
-    }
-    else
+    for ( int row = rowMin; row <= rowMax; row++ )
     {
-        for ( int i = 0; i < obsoleteNodesCount; i++ )
-            delete parentNode->firstChild();
-
-        auto* node = parentNode->lastChild();
+        qreal x = cr.left() + colOffset;
 
-        for ( int row = rowMax; row >= rowMin; row-- )
+        for ( int col = colMin; col <= colMax; col++ )
         {
-            const qreal h = listView->rowHeight() - ( margins.top() + margins.bottom() );
+            auto transformNode = *node++;
 
-            for ( int col = listView->columnCount() - 1; col >= 0; col-- )
-            {
-                const qreal w = listView->columnWidth( col ) - ( margins.left() + margins.right() );
+            QTransform transform;
+            transform.translate( x + margins.left(), y + margins.top() );
 
-                node = updateForegroundNode( listView,
-                    parentNode, static_cast< QSGTransformNode* >( node ),
-                    row, col, QSizeF( w, h ), forward );
+            transformNode->setMatrix( transform );
+            parentNode->appendChildNode( transformNode );
 
-                node = node->previousSibling();
-            }
+            x += listView->columnWidth( col );
         }
+
+        y = cr.top() + listView->rowOffset( row + 1 );
     }
+
+    listViewNode->resetCells( listView, rowMin, rowMax, colMin, colMax, attributes );
 }
 
 QSGTransformNode* QskListViewSkinlet::updateForegroundNode(
-    const QskListView* listView, QSGNode* parentNode, QSGTransformNode* cellNode,
-    int row, int col, const QSizeF& size, bool forward ) const
+    const QskListView* listView, QSGTransformNode* cellNode,
+    int row, int col, const QSizeF& size ) const
 {
     const QRectF cellRect( 0.0, 0.0, size.width(), size.height() );
 
@@ -357,78 +478,31 @@ QSGTransformNode* QskListViewSkinlet::updateForegroundNode(
         Text nodes already have a transform root node - to avoid inserting extra
         transform nodes, the code below becomes a bit more complicated.
      */
-    QSGTransformNode* newCellNode = nullptr;
 
-    if ( cellNode && ( cellNode->type() == QSGNode::TransformNodeType ) )
-    {
-        QSGNode* oldNode = cellNode;
+    QSGNode* oldNode = cellNode;
 
-        auto newNode = updateCellNode( listView, oldNode, cellRect, row, col );
-        if ( newNode )
-        {
-            if ( newNode->type() == QSGNode::TransformNodeType )
-            {
-                newCellNode = static_cast< QSGTransformNode* >( newNode );
-            }
-            else
-            {
-                newCellNode = new QSGTransformNode();
-                newCellNode->appendChildNode( newNode );
-            }
-        }
-    }
-    else
-    {
-        QSGNode* oldNode = cellNode ? cellNode->firstChild() : nullptr;
-        auto newNode = updateCellNode( listView, oldNode, cellRect, row, col );
+    // transform nodes without role have been inserted for the nodes below
+    const bool isWrapper = cellNode && ( QskSGNode::nodeRole( cellNode ) == 0xff );
 
-        if ( newNode )
-        {
-            if ( newNode->type() == QSGNode::TransformNodeType )
-            {
-                newCellNode = static_cast< QSGTransformNode* >( newNode );
-            }
-            else
-            {
-                if ( cellNode == nullptr )
-                {
-                    newCellNode = new QSGTransformNode();
-                    newCellNode->appendChildNode( newNode );
-                }
-                else
-                {
-                    if ( newNode != oldNode )
-                    {
-                        delete cellNode->firstChild();
-                        cellNode->appendChildNode( newNode );
+    if ( isWrapper )
+        oldNode = cellNode->firstChild();
 
-                        newCellNode = cellNode;
-                    }
-                }
-            }
-        }
-    }
+    auto newNode = updateCellNode( listView, oldNode, cellRect, row, col );
+
+    if ( newNode && newNode->type() == QSGNode::TransformNodeType )
+        return static_cast< QSGTransformNode* >( newNode );
 
-    if ( newCellNode == nullptr )
-        newCellNode = new QSGTransformNode();
+    auto wrapperNode = isWrapper ? cellNode : new QSGTransformNode();
 
-    if ( cellNode != newCellNode )
+    if ( newNode != wrapperNode->firstChild() )
     {
-        if ( cellNode )
-        {
-            parentNode->insertChildNodeAfter( newCellNode, cellNode );
-            delete cellNode;
-        }
-        else
-        {
-            if ( forward )
-                parentNode->appendChildNode( newCellNode );
-            else
-                parentNode->prependChildNode( newCellNode );
-        }
+        delete wrapperNode->firstChild();
+
+        if ( newNode )
+            wrapperNode->appendChildNode( newNode );
     }
 
-    return newCellNode;
+    return wrapperNode;
 }
 
 QSGNode* QskListViewSkinlet::updateCellNode( const QskListView* listView,
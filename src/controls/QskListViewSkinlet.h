@@ -11,7 +11,6 @@
 class QskListView;
 class QskListViewNode;
 
-class QMarginsF;
 class QSizeF;
 class QRectF;
 class QSGTransformNode;
@@ -48,14 +47,8 @@ class QSK_EXPORT QskListViewSkinlet : public QskScrollViewSkinlet
     void updateForegroundNodes( const QskListView*, QskListViewNode* ) const;
     void updateBackgroundNodes( const QskListView*, QskListViewNode* ) const;
 
-    void updateVisibleForegroundNodes(
-        const QskListView*, QskListViewNode*,
-        int rowMin, int rowMax, int colMin, int colMax,
-        const QMarginsF& margin, bool forward ) const;
-
     QSGTransformNode* updateForegroundNode( const QskListView*,
-        QSGNode* parentNode, QSGTransformNode* cellNode,
-        int row, int col, const QSizeF&, bool forward ) const;
+        QSGTransformNode* cellNode, int row, int col, const QSizeF& ) const;
 };
 
 #endif
@@ -10,7 +10,9 @@
 #include "QskSetup.h"
 #include "QskSkin.h"
 #include "QskDirtyItemFilter.h"
+#include "QskFrameStatistics.h"
 
+#include <qelapsedtimer.h>
 #include <qglobalstatic.h>
 #include <qquickwindow.h>
 
@@ -909,6 +911,12 @@ void QskQuickItem::updatePolish()
 
     d->blockedPolish = false;
 
+    QElapsedTimer timer;
+
+    const bool isRecording = QskFrameStatistics::isRecording( window() );
+    if ( isRecording )
+        timer.start();
+
     if ( !d->initiallyPainted )
     {
         /*
@@ -920,6 +928,12 @@ void QskQuickItem::updatePolish()
     }
 
     updateItemPolish();
+
+    if ( isRecording )
+    {
+        QskFrameStatistics::count( window(),
+            QskFrameStatistics::PolishTime, timer.nsecsElapsed() );
+    }
 }
 
 void QskQuickItem::aboutToShow()
@@ -940,6 +954,8 @@ QSGNode* QskQuickItem::updatePaintNode( QSGNode* node, UpdatePaintNodeData* data
 
     d->initiallyPainted = true;
 
+    QskFrameStatistics::count( QskFrameStatistics::UpdatePaintNodeCalls );
+
     if ( d->clearPreviousNodes )
     {
         delete node;
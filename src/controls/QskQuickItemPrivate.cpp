@@ -5,6 +5,7 @@
 
 #include "QskQuickItemPrivate.h"
 #include "QskSetup.h"
+#include "QskEvent.h"
 
 static inline void qskSendEventTo( QObject* object, QEvent::Type type )
 {
@@ -84,8 +85,13 @@ void QskQuickItemPrivate::applyUpdateFlags( QskQuickItem::UpdateFlags flags )
 
 void QskQuickItemPrivate::layoutConstraintChanged()
 {
-    if ( auto item = q_func()->parentItem() )
-        qskSendEventTo( item, QEvent::LayoutRequest );
+    Q_Q( QskQuickItem );
+
+    if ( auto item = q->parentItem() )
+    {
+        QskLayoutRequestEvent event( q );
+        QCoreApplication::sendEvent( item, &event );
+    }
 }
 
 void QskQuickItemPrivate::implicitSizeChanged()
@@ -45,6 +45,9 @@ QskSimpleListBox::QskSimpleListBox( QQuickItem* parent )
     : Inherited( parent )
     , m_data( new PrivateData() )
 {
+    // all modifications are notified by rowsInserted/rowsRemoved
+    setIncrementalUpdates( true );
+
     connect( this, &Inherited::selectedRowChanged,
         this, [ this ]( int row ) { Q_EMIT selectedEntryChanged( entryAt( row ) ); } );
 }
@@ -110,9 +113,14 @@ void QskSimpleListBox::insert( const QStringList& list, int index )
     if ( m_data->entries.isEmpty() )
     {
         m_data->entries = list;
+        propagateEntries();
+
+        return;
     }
-    else if ( index < 0 || index >= m_data->entries.size() )
+
+    if ( index < 0 || index >= m_data->entries.size() )
     {
+        index = m_data->entries.size();
         m_data->entries += list;
     }
     else
@@ -122,7 +130,10 @@ void QskSimpleListBox::insert( const QStringList& list, int index )
             m_data->entries.insert( index + i, list[ i ] );
     }
 
-    propagateEntries();
+    // the nodes of the existing entries can be shifted
+    rowsInserted( index, list.size() );
+
+    Q_EMIT entriesChanged();
 }
 
 void QskSimpleListBox::setEntries( const QStringList& entries )
@@ -152,12 +163,19 @@ void QskSimpleListBox::insert( const QString& text, int index )
             m_data->maxTextWidth = w;
     }
 
-    if ( index < 0 )
+    if ( index < 0 || index >= m_data->entries.size() )
+    {
+        index = m_data->entries.size();
         m_data->entries.append( text );
+    }
     else
+    {
         m_data->entries.insert( index, text );
+    }
 
-    propagateEntries();
+    rowsInserted( index, 1 );
+
+    Q_EMIT entriesChanged();
 }
 
 void QskSimpleListBox::removeAt( int index )
@@ -209,7 +227,9 @@ void QskSimpleListBox::removeBulk( int from, int to )
     if ( m_data->columnWidthHint <= 0.0 )
         m_data->maxTextWidth = qskMaxWidth( effectiveFont( Text ), m_data->entries );
 
-    propagateEntries();
+    rowsRemoved( from, to - from + 1 );
+
+    Q_EMIT entriesChanged();
 
     int row = selectedRow();
     if ( row >= 0 )
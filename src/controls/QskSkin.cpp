@@ -11,6 +11,7 @@
 #include "QskGraphic.h"
 #include "QskGraphicProviderMap.h"
 #include "QskSkinHintTable.h"
+#include "QskSkinHintCache.h"
 #include "QskStandardSymbol.h"
 #include "QskPlatform.h"
 
@@ -132,9 +133,15 @@ namespace
 class QskSkin::PrivateData
 {
   public:
+    PrivateData()
+        : hintCache( hintTable )
+    {
+    }
+
     std::unordered_map< const QMetaObject*, SkinletData > skinletMap;
 
     QskSkinHintTable hintTable;
+    QskSkinHintCache hintCache;
 
     std::unordered_map< int, QFont > fonts;
     std::unordered_map< int, QskColorFilter > graphicFilters;
@@ -298,6 +305,17 @@ QskSkinHintTable& QskSkin::hintTable()
     return m_data->hintTable;
 }
 
+const QVariant* QskSkin::resolvedHint(
+    QskAspect aspect, QskAspect* resolvedAspect ) const
+{
+    return m_data->hintCache.resolvedHint( aspect, resolvedAspect );
+}
+
+const QskSkinHintCache& QskSkin::hintCache() const
+{
+    return m_data->hintCache;
+}
+
 const std::unordered_map< int, QFont >& QskSkin::fonts() const
 {
     return m_data->fonts;
@@ -23,6 +23,7 @@ class QskGraphic;
 class QskGraphicProvider;
 
 class QskSkinHintTable;
+class QskSkinHintCache;
 
 class QVariant;
 
@@ -82,6 +83,11 @@ class QSK_EXPORT QskSkin : public QObject
     const QskSkinHintTable& hintTable() const;
     QskSkinHintTable& hintTable();
 
+    const QVariant* resolvedHint( QskAspect,
+        QskAspect* resolvedAspect = nullptr ) const;
+
+    const QskSkinHintCache& hintCache() const;
+
     const std::unordered_map< int, QFont >& fonts() const;
     const std::unordered_map< int, QskColorFilter >& graphicFilters() const;
 
@@ -0,0 +1,195 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskSkinHintCache.h"
+#include "QskSkinHintTable.h"
+
+#include <qdebug.h>
+#include <unordered_map>
+
+namespace
+{
+    class Entry
+    {
+      public:
+        const QVariant* value;
+        QskAspect resolvedAspect;
+    };
+}
+
+static inline const QVariant* qskResolvedSkinHint(
+    const QskSkinHintTable& table, QskAspect aspect, QskAspect* resolvedAspect )
+{
+    if ( const auto value = table.resolvedHint( aspect, resolvedAspect ) )
+        return value;
+
+    if ( aspect.subControl() != QskAspect::Control )
+    {
+        // trying to resolve something from the skin default settings
+
+        aspect.setSubControl( QskAspect::Control );
+        aspect.clearStates();
+
+        return table.resolvedHint( aspect, resolvedAspect );
+    }
+
+    return nullptr;
+}
+
+class QskSkinHintCache::PrivateData
+{
+  public:
+    PrivateData( const QskSkinHintTable& table )
+        : table( table )
+        , generation( table.generation() )
+    {
+    }
+
+    const QskSkinHintTable& table;
+    quint32 generation;
+
+    /*
+        The values are pointers into the unordered_map of the table,
+        that stay valid until the table gets modified. As any
+        modification increases the generation we are on the safe side.
+     */
+    std::unordered_map< QskAspect, Entry > entries;
+
+    quint64 hits = 0;
+    quint64 misses = 0;
+};
+
+QskSkinHintCache::QskSkinHintCache( const QskSkinHintTable& table )
+    : m_data( new PrivateData( table ) )
+{
+}
+
+QskSkinHintCache::~QskSkinHintCache()
+{
+}
+
+const QVariant* QskSkinHintCache::resolvedHint(
+    QskAspect aspect, QskAspect* resolvedAspect ) const
+{
+    const auto& table = m_data->table;
+
+    if ( !table.hasHints() )
+        return nullptr;
+
+    if ( m_data->generation != table.generation() )
+    {
+        m_data->entries.clear();
+        m_data->generation = table.generation();
+    }
+
+    // states, that are not used in the table, do not affect the resolution
+    aspect &= table.states();
+
+    auto it = m_data->entries.find( aspect );
+    if ( it != m_data->entries.end() )
+    {
+        m_data->hits++;
+    }
+    else
+    {
+        m_data->misses++;
+
+        Entry entry;
+        entry.value = qskResolvedSkinHint( table, aspect, &entry.resolvedAspect );
+
+        it = m_data->entries.emplace( aspect, entry ).first;
+    }
+
+    const auto& entry = it->second;
+
+    if ( resolvedAspect && entry.value )
+        *resolvedAspect = entry.resolvedAspect;
+
+    return entry.value;
+}
+
+bool QskSkinHintCache::resolvedMetric(
+    QskAspect aspect, qreal& metric, QskAspect* resolvedAspect ) const
+{
+    QskAspect key;
+    if ( resolvedHint( aspect, &key ) == nullptr )
+        return false;
+
+    if ( resolvedAspect )
+        *resolvedAspect = key;
+
+    // key is an entry of the table: no need to walk the fallback chain again
+    return m_data->table.resolvedMetric( key, metric );
+}
+
+bool QskSkinHintCache::resolvedColor(
+    QskAspect aspect, QRgb& rgb, QskAspect* resolvedAspect ) const
+{
+    QskAspect key;
+    if ( resolvedHint( aspect, &key ) == nullptr )
+        return false;
+
+    if ( resolvedAspect )
+        *resolvedAspect = key;
+
+    return m_data->table.resolvedColor( key, rgb );
+}
+
+bool QskSkinHintCache::resolvedMargins(
+    QskAspect aspect, QskMargins& margins, QskAspect* resolvedAspect ) const
+{
+    QskAspect key;
+    if ( resolvedHint( aspect, &key ) == nullptr )
+        return false;
+
+    if ( resolvedAspect )
+        *resolvedAspect = key;
+
+    return m_data->table.resolvedMargins( key, margins );
+}
+
+void QskSkinHintCache::invalidate()
+{
+    m_data->entries.clear();
+    m_data->generation = m_data->table.generation();
+}
+
+int QskSkinHintCache::count() const
+{
+    return static_cast< int >( m_data->entries.size() );
+}
+
+quint64 QskSkinHintCache::hits() const
+{
+    return m_data->hits;
+}
+
+quint64 QskSkinHintCache::misses() const
+{
+    return m_data->misses;
+}
+
+void QskSkinHintCache::resetCounters()
+{
+    m_data->hits = m_data->misses = 0;
+}
+
+#ifndef QT_NO_DEBUG_STREAM
+
+QDebug operator<<( QDebug debug, const QskSkinHintCache& cache )
+{
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << "QskSkinHintCache" << '(';
+    debug << "entries: " << cache.count()
+          << ", hits: " << cache.hits()
+          << ", misses: " << cache.misses();
+    debug << ')';
+
+    return debug;
+}
+
+#endif
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_SKIN_HINT_CACHE_H
+#define QSK_SKIN_HINT_CACHE_H
+
+#include "QskAspect.h"
+
+#include <qcolor.h>
+#include <memory>
+
+class QskSkinHintTable;
+class QskMargins;
+class QVariant;
+
+/*
+    Resolving a hint from the skin walks through a chain of fallbacks:
+    states, placement, section and finally the QskAspect::Control subcontrol.
+    QskSkinHintCache memorizes the results of this resolution for each
+    fully qualified aspect, so that the chain has to be walked only once.
+
+    The cache is invalidated, whenever the generation of the table changes.
+ */
+class QSK_EXPORT QskSkinHintCache
+{
+  public:
+    QskSkinHintCache( const QskSkinHintTable& );
+    ~QskSkinHintCache();
+
+    const QVariant* resolvedHint( QskAspect,
+        QskAspect* resolvedAspect = nullptr ) const;
+
+    /*
+        Typed lookups: the fallback chain is resolved by the cache, the value
+        is read from the typed arrays of the table, when it is compact.
+     */
+
+    bool resolvedMetric( QskAspect, qreal&,
+        QskAspect* resolvedAspect = nullptr ) const;
+
+    bool resolvedColor( QskAspect, QRgb&,
+        QskAspect* resolvedAspect = nullptr ) const;
+
+    bool resolvedMargins( QskAspect, QskMargins&,
+        QskAspect* resolvedAspect = nullptr ) const;
+
+    void invalidate();
+
+    int count() const;
+
+    quint64 hits() const;
+    quint64 misses() const;
+
+    void resetCounters();
+
+  private:
+    Q_DISABLE_COPY( QskSkinHintCache )
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#ifndef QT_NO_DEBUG_STREAM
+
+class QDebug;
+QSK_EXPORT QDebug operator<<( QDebug, const QskSkinHintCache& );
+
+#endif
+
+#endif
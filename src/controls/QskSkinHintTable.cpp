@@ -5,26 +5,197 @@
 
 #include "QskSkinHintTable.h"
 #include "QskAnimationHint.h"
+#include "QskMargins.h"
 
+#include <qcolor.h>
+
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 const QVariant QskSkinHintTable::invalidHint;
 
-inline const QVariant* qskResolvedHint( QskAspect aspect,
-    const std::unordered_map< QskAspect, QVariant >& hints,
-    QskAspect* resolvedAspect )
+/*
+    The keys are the 64 bit values of the aspects in ascending order.
+    Besides the pointers into the hash map, the values of the most
+    frequently used types are stored in typed arrays, so that
+    they can be retrieved without having to unwrap a QVariant.
+ */
+class QskSkinHintTable::FlatTable
+{
+  public:
+    enum ValueType : quint8
+    {
+        VariantValue,
+
+        MetricValue,
+        ColorValue,
+        MarginsValue
+    };
+
+    FlatTable( const HintMap& hints )
+    {
+        std::vector< const HintMap::value_type* > entries;
+        entries.reserve( hints.size() );
+
+        for ( const auto& entry : hints )
+            entries.push_back( &entry );
+
+        std::sort( entries.begin(), entries.end(),
+            []( const HintMap::value_type* e1, const HintMap::value_type* e2 )
+            { return e1->first < e2->first; } );
+
+        const auto count = entries.size();
+
+        keys.reserve( count );
+        values.reserve( count );
+        valueTypes.reserve( count );
+        valueIndexes.reserve( count );
+
+        for ( const auto entry : entries )
+        {
+            keys.push_back( entry->first.value() );
+            values.push_back( &entry->second );
+
+            append( entry->first, entry->second );
+        }
+    }
+
+    inline int indexOf( QskAspect aspect ) const
+    {
+        /*
+            A lower bound search, where the loop does not depend
+            on the result of the comparisons. The compiler usually
+            translates the ternary operator into a conditional move.
+         */
+
+        const auto key = aspect.value();
+        const auto count = static_cast< int >( keys.size() );
+
+        if ( count == 0 )
+            return -1;
+
+        const quint64* base = keys.data();
+
+        for ( int n = count; n > 1; )
+        {
+            const int half = n / 2;
+            base = ( base[ half ] <= key ) ? base + half : base;
+            n -= half;
+        }
+
+        return ( *base == key ) ? static_cast< int >( base - keys.data() ) : -1;
+    }
+
+    inline const QVariant* find( QskAspect aspect ) const
+    {
+        const auto index = indexOf( aspect );
+        return ( index >= 0 ) ? values[ index ] : nullptr;
+    }
+
+    inline void valueAt( int index, qreal& value ) const
+    {
+        if ( valueTypes[ index ] == MetricValue )
+            value = metrics[ valueIndexes[ index ] ];
+        else
+            value = values[ index ]->value< qreal >();
+    }
+
+    inline void valueAt( int index, QRgb& value ) const
+    {
+        if ( valueTypes[ index ] == ColorValue )
+            value = colors[ valueIndexes[ index ] ];
+        else
+            value = values[ index ]->value< QColor >().rgba();
+    }
+
+    inline void valueAt( int index, QskMargins& value ) const
+    {
+        if ( valueTypes[ index ] == MarginsValue )
+            value = margins[ valueIndexes[ index ] ];
+        else
+            value = values[ index ]->value< QskMargins >();
+    }
+
+    std::vector< quint64 > keys;
+    std::vector< const QVariant* > values;
+
+    std::vector< quint8 > valueTypes;
+    std::vector< int > valueIndexes;
+
+    std::vector< qreal > metrics;
+    std::vector< QRgb > colors;
+    std::vector< QskMargins > margins;
+
+  private:
+    void append( QskAspect aspect, const QVariant& value )
+    {
+        auto valueType = VariantValue;
+        int valueIndex = -1;
+
+        const int userType = value.userType();
+
+        if ( aspect.isMetric() )
+        {
+            switch( userType )
+            {
+                case QMetaType::Double:
+                case QMetaType::Float:
+                case QMetaType::Int:
+                case QMetaType::UInt:
+                {
+                    valueType = MetricValue;
+                    valueIndex = static_cast< int >( metrics.size() );
+                    metrics.push_back( value.value< qreal >() );
+
+                    break;
+                }
+                default:
+                {
+                    if ( userType == qMetaTypeId< QskMargins >() )
+                    {
+                        valueType = MarginsValue;
+                        valueIndex = static_cast< int >( margins.size() );
+                        margins.push_back( value.value< QskMargins >() );
+                    }
+                }
+            }
+        }
+        else if ( aspect.isColor() )
+        {
+            if ( userType == QMetaType::QColor )
+            {
+                valueType = ColorValue;
+                valueIndex = static_cast< int >( colors.size() );
+                colors.push_back( value.value< QColor >().rgba() );
+            }
+            else if ( userType == QMetaType::UInt )
+            {
+                valueType = ColorValue;
+                valueIndex = static_cast< int >( colors.size() );
+                colors.push_back( value.value< QRgb >() );
+            }
+        }
+
+        valueTypes.push_back( valueType );
+        valueIndexes.push_back( valueIndex );
+    }
+};
+
+template< typename Lookup >
+static inline const QVariant* qskResolvedHint( QskAspect aspect,
+    const Lookup& lookup, QskAspect* resolvedAspect )
 {
     auto a = aspect;
 
     Q_FOREVER
     {
-        auto it = hints.find( aspect );
-        if ( it != hints.cend() )
+        if ( const auto value = lookup( aspect ) )
         {
             if ( resolvedAspect )
                 *resolvedAspect = aspect;
 
-            return &it->second;
+            return value;
         }
 
 #if 1
@@ -76,9 +247,53 @@ QskSkinHintTable::QskSkinHintTable()
 
 QskSkinHintTable::~QskSkinHintTable()
 {
+    delete m_flatTable;
     delete m_hints;
 }
 
+const QskSkinHintTable::FlatTable* QskSkinHintTable::flatTable() const
+{
+    if ( m_compact && m_flatTable == nullptr && m_hints )
+    {
+        // rebuilding what has been dropped by the last modification
+        m_flatTable = new FlatTable( *m_hints );
+    }
+
+    return m_flatTable;
+}
+
+const QVariant* QskSkinHintTable::findHint( QskAspect aspect ) const
+{
+    if ( const auto flatTable = this->flatTable() )
+        return flatTable->find( aspect );
+
+    if ( m_hints != nullptr )
+    {
+        auto it = m_hints->find( aspect );
+        if ( it != m_hints->cend() )
+            return &it->second;
+    }
+
+    return nullptr;
+}
+
+void QskSkinHintTable::setModified()
+{
+    m_generation++;
+
+    delete m_flatTable;
+    m_flatTable = nullptr;
+}
+
+void QskSkinHintTable::compact()
+{
+    delete m_flatTable;
+    m_flatTable = nullptr;
+
+    m_compact = true;
+    flatTable();
+}
+
 const std::unordered_map< QskAspect, QVariant >& QskSkinHintTable::hints() const
 {
     if ( m_hints )
@@ -107,6 +322,7 @@ bool QskSkinHintTable::setHint( QskAspect aspect, const QVariant& skinHint )
         }
 
         m_states |= aspect.states();
+        setModified();
 
         return true;
     }
@@ -114,6 +330,8 @@ bool QskSkinHintTable::setHint( QskAspect aspect, const QVariant& skinHint )
     if ( it->second != skinHint )
     {
         it->second = skinHint;
+        setModified();
+
         return true;
     }
 
@@ -131,6 +349,8 @@ bool QskSkinHintTable::removeHint( QskAspect aspect )
 
     if ( erased )
     {
+        setModified();
+
         if ( aspect.isAnimator() )
             m_animatorCount--;
 
@@ -156,6 +376,8 @@ QVariant QskSkinHintTable::takeHint( QskAspect aspect )
             const auto value = it->second;
             m_hints->erase( it );
 
+            setModified();
+
             if ( aspect.isAnimator() )
                 m_animatorCount--;
 
@@ -181,23 +403,90 @@ void QskSkinHintTable::clear()
 
     m_animatorCount = 0;
     m_states = QskAspect::NoState;
+
+    setModified();
 }
 
 const QVariant* QskSkinHintTable::resolvedHint(
     QskAspect aspect, QskAspect* resolvedAspect ) const
 {
     if ( m_hints != nullptr )
-        return qskResolvedHint( aspect & m_states, *m_hints, resolvedAspect );
+    {
+        const auto lookup = [this]( QskAspect key ) { return findHint( key ); };
+        return qskResolvedHint( aspect & m_states, lookup, resolvedAspect );
+    }
 
     return nullptr;
 }
 
+template< typename T >
+inline bool QskSkinHintTable::resolvedValue(
+    QskAspect aspect, T& value, QskAspect* resolvedAspect ) const
+{
+    if ( const auto flatTable = this->flatTable() )
+    {
+        int index = -1;
+
+        const auto lookup = [flatTable, &index]( QskAspect key )
+        {
+            index = flatTable->indexOf( key );
+            return ( index >= 0 ) ? flatTable->values[ index ] : nullptr;
+        };
+
+        if ( qskResolvedHint( aspect & m_states, lookup, resolvedAspect ) )
+        {
+            flatTable->valueAt( index, value );
+            return true;
+        }
+
+        return false;
+    }
+
+    if ( const auto hint = resolvedHint( aspect, resolvedAspect ) )
+    {
+        value = hint->value< T >();
+        return true;
+    }
+
+    return false;
+}
+
+bool QskSkinHintTable::resolvedMetric(
+    QskAspect aspect, qreal& metric, QskAspect* resolvedAspect ) const
+{
+    return resolvedValue( aspect, metric, resolvedAspect );
+}
+
+bool QskSkinHintTable::resolvedColor(
+    QskAspect aspect, QRgb& rgb, QskAspect* resolvedAspect ) const
+{
+    if ( isCompact() )
+        return resolvedValue( aspect, rgb, resolvedAspect );
+
+    if ( const auto hint = resolvedHint( aspect, resolvedAspect ) )
+    {
+        rgb = hint->value< QColor >().rgba();
+        return true;
+    }
+
+    return false;
+}
+
+bool QskSkinHintTable::resolvedMargins(
+    QskAspect aspect, QskMargins& margins, QskAspect* resolvedAspect ) const
+{
+    return resolvedValue( aspect, margins, resolvedAspect );
+}
+
 QskAspect QskSkinHintTable::resolvedAspect( QskAspect aspect ) const
 {
     QskAspect a;
 
     if ( m_hints != nullptr )
-        qskResolvedHint( aspect & m_states, *m_hints, &a );
+    {
+        const auto lookup = [this]( QskAspect key ) { return findHint( key ); };
+        qskResolvedHint( aspect & m_states, lookup, &a );
+    }
 
     return a;
 }
@@ -211,10 +500,9 @@ QskAspect QskSkinHintTable::resolvedAnimator(
 
         Q_FOREVER
         {
-            auto it = m_hints->find( aspect );
-            if ( it != m_hints->cend() )
+            if ( const auto value = findHint( aspect ) )
             {
-                hint = it->second.value< QskAnimationHint >();
+                hint = value->value< QskAnimationHint >();
                 return aspect;
             }
 
@@ -12,6 +12,7 @@
 #include <unordered_map>
 
 class QskAnimationHint;
+class QskMargins;
 
 class QSK_EXPORT QskSkinHintTable
 {
@@ -40,11 +41,42 @@ class QSK_EXPORT QskSkinHintTable
 
     QskAspect::States states() const;
 
+    /*
+        The generation is increased with every modification of the table
+        and can be used to find out if values, that have been derived
+        from it, are outdated.
+     */
+    quint32 generation() const;
+
+    /*
+        Creates a sorted, flat representation of the hints, that is
+        faster for lookups than the hash map. It should be called,
+        when the table has been set up completely.
+
+        Any later modification drops the flat representation, but
+        the table stays compact and rebuilds it with the next lookup.
+        So modifications should be done in bulk to avoid rebuilding
+        it over and over.
+     */
+    void compact();
+    bool isCompact() const;
+
     void clear();
 
     const QVariant* resolvedHint( QskAspect,
         QskAspect* resolvedAspect = nullptr ) const;
 
+    // typed lookups, that do not need to unwrap a QVariant for compact tables
+
+    bool resolvedMetric( QskAspect, qreal&,
+        QskAspect* resolvedAspect = nullptr ) const;
+
+    bool resolvedColor( QskAspect, QRgb&,
+        QskAspect* resolvedAspect = nullptr ) const;
+
+    bool resolvedMargins( QskAspect, QskMargins&,
+        QskAspect* resolvedAspect = nullptr ) const;
+
     QskAspect resolvedAspect( QskAspect ) const;
 
     QskAspect resolvedAnimator(
@@ -55,13 +87,28 @@ class QSK_EXPORT QskSkinHintTable
   private:
     Q_DISABLE_COPY( QskSkinHintTable )
 
+    const QVariant* findHint( QskAspect ) const;
+    void setModified();
+
+    class FlatTable;
+    const FlatTable* flatTable() const;
+
+    template< typename T >
+    bool resolvedValue( QskAspect, T&, QskAspect* ) const;
+
     static const QVariant invalidHint;
 
     typedef std::unordered_map< QskAspect, QVariant > HintMap;
     HintMap* m_hints = nullptr;
 
+    mutable FlatTable* m_flatTable = nullptr;
+
     unsigned short m_animatorCount = 0;
+    bool m_compact = false;
+
     QskAspect::States m_states;
+
+    quint32 m_generation = 0;
 };
 
 inline bool QskSkinHintTable::hasHints() const
@@ -74,27 +121,30 @@ inline QskAspect::States QskSkinHintTable::states() const
     return m_states;
 }
 
+inline quint32 QskSkinHintTable::generation() const
+{
+    return m_generation;
+}
+
 inline bool QskSkinHintTable::hasAnimators() const
 {
     return m_animatorCount > 0;
 }
 
-inline bool QskSkinHintTable::hasHint( QskAspect aspect ) const
+inline bool QskSkinHintTable::isCompact() const
 {
-    if ( m_hints != nullptr )
-        return m_hints->find( aspect ) != m_hints->cend();
+    return m_compact;
+}
 
-    return false;
+inline bool QskSkinHintTable::hasHint( QskAspect aspect ) const
+{
+    return findHint( aspect ) != nullptr;
 }
 
 inline const QVariant& QskSkinHintTable::hint( QskAspect aspect ) const
 {
-    if ( m_hints != nullptr )
-    {
-        auto it = m_hints->find( aspect );
-        if ( it != m_hints->cend() )
-            return it->second;
-    }
+    if ( const auto value = findHint( aspect ) )
+        return *value;
 
     return invalidHint;
 }
@@ -5,6 +5,8 @@
 
 #include "QskSkinManager.h"
 #include "QskSkinFactory.h"
+#include "QskSkin.h"
+#include "QskSkinHintTable.h"
 
 #include <qdir.h>
 #include <qglobalstatic.h>
@@ -513,7 +515,14 @@ QskSkin* QskSkinManager::createSkin( const QString& skinName ) const
         }
     }
 
-    return factory ? factory->createSkin( name ) : nullptr;
+    auto skin = factory ? factory->createSkin( name ) : nullptr;
+    if ( skin )
+    {
+        // the setup of the skin is completed: optimizing the table for lookups
+        skin->hintTable().compact();
+    }
+
+    return skin;
 }
 
 #include "moc_QskSkinManager.cpp"
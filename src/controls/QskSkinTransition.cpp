@@ -8,13 +8,17 @@
 #include "QskControl.h"
 #include "QskWindow.h"
 #include "QskAnimationHint.h"
-#include "QskHintAnimator.h"
 #include "QskSkin.h"
 #include "QskSkinHintTable.h"
+#include "QskSubcontrolIndex.h"
+#include "QskVariantAnimator.h"
 
+#include <qcolor.h>
 #include <qglobalstatic.h>
 #include <qguiapplication.h>
+#include <qhash.h>
 #include <qobject.h>
+#include <qset.h>
 #include <qvector.h>
 
 #include <unordered_map>
@@ -75,6 +79,22 @@ static void qskAddCandidates( const QskSkinTransition::Type mask,
     }
 }
 
+namespace
+{
+    // the candidates grouped by their subcontrols
+    using CandidateMap = QHash< quint16, QVector< QskAspect > >;
+}
+
+static CandidateMap qskCandidateMap( const QSet< QskAspect >& candidates )
+{
+    CandidateMap map;
+
+    for ( const auto aspect : candidates )
+        map[ aspect.subControl() ] += aspect;
+
+    return map;
+}
+
 namespace
 {
     class UpdateInfo
@@ -95,22 +115,70 @@ namespace
         int updateModes;
     };
 
-    class HintAnimator : public QskHintAnimator
+    // a QskVariantAnimator, that is advanced manually
+    class VariantInterpolator : public QskVariantAnimator
     {
       public:
-        inline HintAnimator( const QskControl* control, const QskAspect aspect,
-            const QVariant& value1, const QVariant& value2, QskAnimationHint hint )
+        using QskVariantAnimator::setup;
+        using QskVariantAnimator::advance;
+    };
+
+    /*
+        All hints of a window are animated with the same animation hint.
+        So instead of having an animator for each hint, we interpolate
+        all of them in one pass, when advancing the table.
+
+        Colors and metrics are stored in flat arrays: colors as RGBA lanes
+        of floats, metrics as qreals. Their interpolation is a loop over
+        those arrays, that can be vectorized by the compiler. All other types
+        are interpolated by the interpolators of QVariantAnimation.
+
+        Reading a hint is a lookup of its slot in the table.
+     */
+    class HintTable : public QskAnimator
+    {
+      public:
+        bool contains( QskAspect ) const;
+        void insert( QskAspect, const QVariant& from, const QVariant& to );
+
+        bool isEmpty() const;
+
+        QVariant value( QskAspect ) const;
+        QVariant resolvedValue( QskAspect, QskAspect* ) const;
+
+      protected:
+        void setup() override;
+        void advance( qreal ) override;
+
+      private:
+        enum SlotType : quint8
+        {
+            ColorSlot,
+            MetricSlot,
+            VariantSlot
+        };
+
+        class Slot
         {
-            setAspect( aspect );
-            setStartValue( value1 );
-            setEndValue( value2 );
+          public:
+            SlotType type;
+            int index;
+        };
 
-            setDuration( hint.duration );
-            setEasingCurve( hint.type );
-            setUpdateFlags( hint.updateFlags );
+        QHash< QskAspect, Slot > m_slots;
 
-            setWindow( control->window() );
-        }
+        // the aspects without placement and states, for rejecting lookups early
+        QSet< QskAspect > m_trunks;
+
+        QVector< float > m_colorStart;
+        QVector< float > m_colorDelta;
+        QVector< float > m_colors;
+
+        QVector< qreal > m_metricStart;
+        QVector< qreal > m_metricDelta;
+        QVector< qreal > m_metrics;
+
+        std::vector< VariantInterpolator > m_variants;
     };
 
     class WindowAnimator
@@ -124,33 +192,40 @@ namespace
         bool isRunning() const;
 
         QVariant animatedHint( QskAspect ) const;
+        QVariant resolvedAnimatedHint( QskAspect, QskAspect* ) const;
         QVariant animatedGraphicFilter( int graphicRole ) const;
 
         void addGraphicFilterAnimators( const QskAnimationHint&,
             const QskSkin*, const QskSkin* );
 
-        void addItemAspects( QQuickItem*,
-            const QskAnimationHint&, const QSet< QskAspect >&,
+        bool hasGraphicFilterAnimators() const;
+
+        void addControlAspects( const QVector< QskControl* >&,
+            const QskAnimationHint&, const CandidateMap&,
             const QskSkin*, const QskSkin* );
 
+        void updateControls( const QVector< QskControl* >&, const QskSkin* );
+
         void update();
 
       private:
+        bool isControlShown( const QskControl*, const QskSkin* ) const;
 
         bool isControlAffected( const QskControl*,
             const QVector< QskAspect::Subcontrol >&, QskAspect ) const;
 
         void addHints( const QskControl*,
-            const QskAnimationHint&, const QSet< QskAspect >& candidates,
+            const QskAnimationHint&, const QVector< QskAspect >& candidates,
+            const QVector< QskAspect::Subcontrol >& subControls,
             const QskSkin* skin1, const QskSkin* skin2 );
 
-        void storeAnimator( const QskControl*, const QskAspect,
+        void storeAnimator( const QskAspect,
             const QVariant&, const QVariant&, QskAnimationHint );
 
         void storeUpdateInfo( const QskControl*, QskAspect );
 
         QQuickWindow* m_window;
-        std::unordered_map< QskAspect, HintAnimator > m_animatorMap;
+        HintTable m_hintTable;
         std::unordered_map< int, QskVariantAnimator > m_graphicFilterAnimatorMap;
         std::vector< UpdateInfo > m_updateInfos; // vector: for fast iteration
     };
@@ -190,9 +265,196 @@ namespace
 
 Q_GLOBAL_STATIC( ApplicationAnimator, qskApplicationAnimator )
 
+inline bool HintTable::contains( QskAspect aspect ) const
+{
+    return m_slots.contains( aspect );
+}
+
+void HintTable::insert( QskAspect aspect, const QVariant& from, const QVariant& to )
+{
+    auto v1 = from;
+    auto v2 = to;
+
+    Slot slot;
+
+    if ( QskVariantAnimator::convertValues( v1, v2 )
+        && ( v1.userType() == QMetaType::QColor ) )
+    {
+        const auto c1 = v1.value< QColor >();
+        const auto c2 = v2.value< QColor >();
+
+        if ( c1.isValid() && c2.isValid() )
+        {
+            const float rgba1[] = { float( c1.redF() ), float( c1.greenF() ),
+                float( c1.blueF() ), float( c1.alphaF() ) };
+
+            const float rgba2[] = { float( c2.redF() ), float( c2.greenF() ),
+                float( c2.blueF() ), float( c2.alphaF() ) };
+
+            slot.type = ColorSlot;
+            slot.index = m_colors.size();
+
+            for ( int i = 0; i < 4; i++ )
+            {
+                m_colorStart += rgba1[ i ];
+                m_colorDelta += rgba2[ i ] - rgba1[ i ];
+                m_colors += rgba1[ i ];
+            }
+
+            m_slots.insert( aspect, slot );
+            m_trunks.insert( aspect.trunk() );
+
+            return;
+        }
+    }
+
+    if ( v1.isValid() && ( v1.userType() == v2.userType() )
+        && ( v1.userType() == QMetaType::Double || v1.userType() == QMetaType::Float ) )
+    {
+        const auto m1 = v1.value< qreal >();
+        const auto m2 = v2.value< qreal >();
+
+        slot.type = MetricSlot;
+        slot.index = m_metrics.size();
+
+        m_metricStart += m1;
+        m_metricDelta += m2 - m1;
+        m_metrics += m1;
+    }
+    else
+    {
+        VariantInterpolator interpolator;
+        interpolator.setStartValue( from );
+        interpolator.setEndValue( to );
+
+        slot.type = VariantSlot;
+        slot.index = static_cast< int >( m_variants.size() );
+
+        m_variants.push_back( interpolator );
+    }
+
+    m_slots.insert( aspect, slot );
+    m_trunks.insert( aspect.trunk() );
+}
+
+inline bool HintTable::isEmpty() const
+{
+    return m_slots.isEmpty();
+}
+
+void HintTable::setup()
+{
+    m_colors = m_colorStart;
+    m_metrics = m_metricStart;
+
+    for ( auto& interpolator : m_variants )
+        interpolator.setup();
+}
+
+void HintTable::advance( qreal progress )
+{
+    {
+        const auto start = m_colorStart.constData();
+        const auto delta = m_colorDelta.constData();
+        auto values = m_colors.data();
+
+        const float p = progress;
+
+        for ( int i = 0; i < m_colors.size(); i++ )
+            values[ i ] = start[ i ] + p * delta[ i ];
+    }
+
+    {
+        const auto start = m_metricStart.constData();
+        const auto delta = m_metricDelta.constData();
+        auto values = m_metrics.data();
+
+        for ( int i = 0; i < m_metrics.size(); i++ )
+            values[ i ] = start[ i ] + progress * delta[ i ];
+    }
+
+    for ( auto& interpolator : m_variants )
+        interpolator.advance( progress );
+}
+
+QVariant HintTable::value( QskAspect aspect ) const
+{
+    if ( !isRunning() )
+        return QVariant();
+
+    const auto it = m_slots.constFind( aspect );
+    if ( it == m_slots.constEnd() )
+        return QVariant();
+
+    const auto& slot = it.value();
+
+    switch( slot.type )
+    {
+        case ColorSlot:
+        {
+            const auto rgba = m_colors.constData() + slot.index;
+            return QColor::fromRgbF( rgba[0], rgba[1], rgba[2], rgba[3] );
+        }
+        case MetricSlot:
+        {
+            return QVariant( m_metrics[ slot.index ] );
+        }
+        default:
+        {
+            return m_variants[ slot.index ].currentValue();
+        }
+    }
+}
+
+QVariant HintTable::resolvedValue( QskAspect aspect, QskAspect* resolvedAspect ) const
+{
+    if ( !isRunning() || !m_trunks.contains( aspect.trunk() ) )
+        return QVariant();
+
+    /*
+        Falling back to aspects with less states and
+        finally without placement, like the skin does
+     */
+
+    const auto a = aspect;
+
+    QVariant v;
+
+    Q_FOREVER
+    {
+        v = value( aspect );
+
+        if ( !v.isValid() )
+        {
+            if ( const auto topState = aspect.topState() )
+            {
+                aspect.clearState( aspect.topState() );
+                continue;
+            }
+
+            if ( aspect.placement() )
+            {
+                // clear the placement bits and restart
+                aspect = a;
+                aspect.setPlacement( QskAspect::NoPlacement );
+
+                continue;
+            }
+        }
+
+        break;
+    }
+
+    if ( resolvedAspect )
+        *resolvedAspect = aspect;
+
+    return v;
+}
+
 WindowAnimator::WindowAnimator( QQuickWindow* window )
     : m_window( window )
 {
+    m_hintTable.setWindow( window );
 }
 
 inline const QQuickWindow* WindowAnimator::window() const
@@ -202,8 +464,8 @@ inline const QQuickWindow* WindowAnimator::window() const
 
 void WindowAnimator::start()
 {
-    for ( auto& it : m_animatorMap )
-        it.second.start();
+    if ( !m_hintTable.isEmpty() )
+        m_hintTable.start();
 
     for ( auto& it : m_graphicFilterAnimatorMap )
         it.second.start();
@@ -211,12 +473,8 @@ void WindowAnimator::start()
 
 bool WindowAnimator::isRunning() const
 {
-    if ( !m_animatorMap.empty() )
-    {
-        const auto& animator = m_animatorMap.begin()->second;
-        if ( animator.isRunning() )
-            return true;
-    }
+    if ( m_hintTable.isRunning() )
+        return true;
 
     if ( !m_graphicFilterAnimatorMap.empty() )
     {
@@ -230,15 +488,13 @@ bool WindowAnimator::isRunning() const
 
 inline QVariant WindowAnimator::animatedHint( QskAspect aspect ) const
 {
-    auto it = m_animatorMap.find( aspect );
-    if ( it != m_animatorMap.cend() )
-    {
-        const auto& animator = it->second;
-        if ( animator.isRunning() )
-            return animator.currentValue();
-    }
+    return m_hintTable.value( aspect );
+}
 
-    return QVariant();
+inline QVariant WindowAnimator::resolvedAnimatedHint(
+    QskAspect aspect, QskAspect* resolvedAspect ) const
+{
+    return m_hintTable.resolvedValue( aspect, resolvedAspect );
 }
 
 inline QVariant WindowAnimator::animatedGraphicFilter( int graphicRole ) const
@@ -285,32 +541,59 @@ void WindowAnimator::addGraphicFilterAnimators( const QskAnimationHint& animator
     }
 }
 
-void WindowAnimator::addItemAspects( QQuickItem* item,
-    const QskAnimationHint& animatorHint, const QSet< QskAspect >& candidates,
-    const QskSkin* skin1, const QskSkin* skin2  )
+inline bool WindowAnimator::hasGraphicFilterAnimators() const
 {
-    if ( !item->isVisible() )
-        return;
+    return !m_graphicFilterAnimatorMap.empty();
+}
 
-    if ( auto control = qskControlCast( item ) )
+inline bool WindowAnimator::isControlShown(
+    const QskControl* control, const QskSkin* skin ) const
+{
+    // QQuickItem::isVisible includes the visibility of the parents
+    return ( control->window() == m_window ) && control->isVisible()
+        && control->isInitiallyPainted() && ( control->effectiveSkin() == skin );
+}
+
+void WindowAnimator::addControlAspects( const QVector< QskControl* >& controls,
+    const QskAnimationHint& animatorHint, const CandidateMap& candidates,
+    const QskSkin* skin1, const QskSkin* skin2 )
+{
+    for ( const auto control : controls )
     {
-        if ( control->isInitiallyPainted() && ( control->effectiveSkin() == skin2 ) )
+        if ( !isControlShown( control, skin2 ) )
+            continue;
+
+        const auto subControls = control->subControls();
+
+        auto it = candidates.constFind( QskAspect::Control );
+        if ( it != candidates.constEnd() )
+            addHints( control, animatorHint, it.value(), subControls, skin1, skin2 );
+
+        for ( const auto subControl : subControls )
         {
-            addHints( control, animatorHint, candidates, skin1, skin2 );
-#if 1
-            /*
-                As it is hard to identify which controls depend on the animated
-                graphic filters we schedule an initial update and let the
-                controls do the rest: see QskSkinnable::effectiveGraphicFilter
-             */
-            control->update();
-#endif
+            if ( subControl == QskAspect::Control )
+                continue;
+
+            it = candidates.constFind( subControl );
+            if ( it != candidates.constEnd() )
+                addHints( control, animatorHint, it.value(), subControls, skin1, skin2 );
         }
     }
+}
 
-    const auto children = item->childItems();
-    for ( auto child : children )
-        addItemAspects( child, animatorHint, candidates, skin1, skin2 );
+void WindowAnimator::updateControls(
+    const QVector< QskControl* >& controls, const QskSkin* skin )
+{
+    /*
+        As it is hard to identify which controls depend on the animated
+        graphic filters we schedule an initial update and let the
+        controls do the rest: see QskSkinnable::effectiveGraphicFilter
+     */
+    for ( const auto control : controls )
+    {
+        if ( isControlShown( control, skin ) )
+            control->update();
+    }
 }
 
 void WindowAnimator::update()
@@ -332,11 +615,10 @@ void WindowAnimator::update()
 }
 
 void WindowAnimator::addHints( const QskControl* control,
-    const QskAnimationHint& animatorHint, const QSet< QskAspect >& candidates,
+    const QskAnimationHint& animatorHint, const QVector< QskAspect >& candidates,
+    const QVector< QskAspect::Subcontrol >& subControls,
     const QskSkin* skin1, const QskSkin* skin2 )
 {
-    const auto subControls = control->subControls();
-
     const auto& localTable = control->hintTable();
 
     const auto& table1 = skin1->hintTable();
@@ -371,7 +653,7 @@ void WindowAnimator::addHints( const QskControl* control,
                 if ( r1.states() == r2.states() )
                     aspect.setStates( r2.states() );
 
-                storeAnimator( control, aspect, *v1, *v2, animatorHint );
+                storeAnimator( aspect, *v1, *v2, animatorHint );
                 storeUpdateInfo( control, aspect );
             }
         }
@@ -380,7 +662,7 @@ void WindowAnimator::addHints( const QskControl* control,
             aspect.setPlacement( r1.placement() );
             aspect.setStates( r1.states() );
 
-            storeAnimator( control, aspect, *v1, QVariant(), animatorHint );
+            storeAnimator( aspect, *v1, QVariant(), animatorHint );
             storeUpdateInfo( control, aspect );
         }
         else if ( v2 )
@@ -388,7 +670,7 @@ void WindowAnimator::addHints( const QskControl* control,
             aspect.setPlacement( r1.placement() );
             aspect.setStates( r1.states() );
 
-            storeAnimator( control, aspect, QVariant(), *v2, animatorHint );
+            storeAnimator( aspect, QVariant(), *v2, animatorHint );
             storeUpdateInfo( control, aspect );
         }
     }
@@ -436,13 +718,16 @@ inline bool WindowAnimator::isControlAffected( const QskControl* control,
     return true;
 }
 
-inline void WindowAnimator::storeAnimator( const QskControl* control, const QskAspect aspect,
+inline void WindowAnimator::storeAnimator( const QskAspect aspect,
     const QVariant& value1, const QVariant& value2, QskAnimationHint hint )
 {
-    if ( m_animatorMap.find( aspect ) == m_animatorMap.cend() )
+    if ( !m_hintTable.contains( aspect ) )
     {
-        m_animatorMap.emplace( aspect,
-            HintAnimator( control, aspect, value1, value2, hint ) );
+        // all hints have the same animation hint
+        m_hintTable.setDuration( hint.duration );
+        m_hintTable.setEasingCurve( hint.type );
+
+        m_hintTable.insert( aspect, value1, value2 );
     }
 }
 
@@ -633,10 +918,26 @@ void QskSkinTransition::process()
         }
     }
 
-    if ( !candidates.isEmpty() )
+    auto index = QskSubcontrolIndex::instance();
+
+    if ( !candidates.isEmpty() && index )
     {
         bool doGraphicFilter = m_data->mask & QskSkinTransition::Color;
 
+        const auto candidateMap = qskCandidateMap( candidates );
+
+        /*
+            Instead of running over the item trees we look up the controls,
+            that are made of the subcontrols of the candidates
+         */
+        QVector< QskAspect::Subcontrol > subControls;
+        subControls.reserve( candidateMap.size() );
+
+        for ( auto it = candidateMap.keyBegin(); it != candidateMap.keyEnd(); ++it )
+            subControls += static_cast< QskAspect::Subcontrol >( *it );
+
+        const auto controls = index->controls( subControls );
+
         const auto windows = qGuiApp->topLevelWindows();
 
         for ( const auto window : windows )
@@ -658,13 +959,11 @@ void QskSkinTransition::process()
                     doGraphicFilter = false;
                 }
 
-                /*
-                   finally we schedule the animators the hard way by running
-                   over the the item trees.
-                 */
+                animator->addControlAspects( controls,
+                    m_data->animationHint, candidateMap, skin1, skin2 );
 
-                animator->addItemAspects( w->contentItem(),
-                    m_data->animationHint, candidates, skin1, skin2 );
+                if ( animator->hasGraphicFilterAnimators() )
+                    animator->updateControls( index->controls(), skin2 );
 
                 qskApplicationAnimator->add( animator );
             }
@@ -697,6 +996,18 @@ QVariant QskSkinTransition::animatedHint(
     return QVariant();
 }
 
+QVariant QskSkinTransition::resolvedAnimatedHint(
+    const QQuickWindow* window, QskAspect aspect, QskAspect* resolvedAspect )
+{
+    if ( qskApplicationAnimator.exists() )
+    {
+        if ( const auto animator = qskApplicationAnimator->windowAnimator( window ) )
+            return animator->resolvedAnimatedHint( aspect, resolvedAspect );
+    }
+
+    return QVariant();
+}
+
 QVariant QskSkinTransition::animatedGraphicFilter(
     const QQuickWindow* window, int graphicRole )
 {
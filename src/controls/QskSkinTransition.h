@@ -39,6 +39,14 @@ class QSK_EXPORT QskSkinTransition
 
     static bool isRunning();
     static QVariant animatedHint( const QQuickWindow*, QskAspect );
+
+    /*
+        Falling back to aspects with less states and finally without placement,
+        when there is no animated hint for the aspect itself
+     */
+    static QVariant resolvedAnimatedHint( const QQuickWindow*,
+        QskAspect, QskAspect* resolvedAspect = nullptr );
+
     static QVariant animatedGraphicFilter( const QQuickWindow*, int graphicRole );
 
   protected:
@@ -155,12 +155,23 @@ static inline QskTextColors qskTextColors(
     QskSkinHintStatus status;
 
     QskTextColors c;
-    c.textColor = skinnable->color( subControl, &status );
+    c.textColor = QColor::fromRgba( skinnable->rgb( subControl, &status ) );
 #if 1
     if ( !status.isValid() )
-        c.textColor = skinnable->color( subControl | QskAspect::TextColor );
+    {
+        c.textColor = QColor::fromRgba(
+            skinnable->rgb( subControl | QskAspect::TextColor, &status ) );
+    }
 #endif
 
+    if ( !status.isValid() )
+        c.textColor = QColor();
+
+    /*
+        The style and link colors are optional: an invalid color
+        makes QQuickText use its default. As rgb() returns 0 for hints,
+        that are not set, we have to use color() here.
+     */
     c.styleColor = skinnable->color( subControl | QskAspect::StyleColor );
     c.linkColor = skinnable->color( subControl | QskAspect::LinkColor );
 
@@ -14,9 +14,11 @@
 #include "QskMargins.h"
 #include "QskSetup.h"
 #include "QskSkin.h"
+#include "QskSkinHintCache.h"
 #include "QskSkinHintTable.h"
 #include "QskSkinTransition.h"
 #include "QskSkinlet.h"
+#include "QskSubcontrolIndex.h"
 #include "QskWindow.h"
 
 #include "QskBoxShapeMetrics.h"
@@ -29,6 +31,7 @@
 #include <qfont.h>
 #include <qfontmetrics.h>
 #include <map>
+#include <type_traits>
 
 #define DEBUG_MAP 0
 #define DEBUG_ANIMATOR 0
@@ -45,12 +48,6 @@ static inline bool qskSetFlag( QskSkinnable* skinnable,
     return skinnable->setSkinHint( aspect | QskAspect::Flag, QVariant( flag ) );
 }
 
-static inline int qskFlag( const QskSkinnable* skinnable,
-    const QskAspect aspect, QskSkinHintStatus* status = nullptr )
-{
-    return skinnable->effectiveSkinHint( aspect | QskAspect::Flag, status ).toInt();
-}
-
 static inline bool qskSetMetric( QskSkinnable* skinnable,
     const QskAspect aspect, const QVariant& metric )
 {
@@ -77,14 +74,6 @@ static inline bool qskMoveMetric( QskSkinnable* skinnable,
     return qskMoveMetric( skinnable, aspect, QVariant::fromValue( metric ) );
 }
 
-template< typename T >
-static inline T qskMetric( const QskSkinnable* skinnable,
-    QskAspect aspect, QskSkinHintStatus* status = nullptr )
-{
-    return skinnable->effectiveSkinHint(
-        aspect | QskAspect::Metric, status ).value< T >();
-}
-
 static inline bool qskSetColor( QskSkinnable* skinnable,
     const QskAspect aspect, const QVariant& color )
 {
@@ -111,14 +100,6 @@ static inline bool qskMoveColor( QskSkinnable* skinnable,
     return qskMoveColor( skinnable, aspect, QVariant::fromValue( color ) );
 }
 
-template< typename T >
-static inline T qskColor( const QskSkinnable* skinnable,
-    QskAspect aspect, QskSkinHintStatus* status = nullptr )
-{
-    return skinnable->effectiveSkinHint(
-        aspect | QskAspect::Color, status ).value< T >();
-}
-
 static inline void qskTriggerUpdates( QskAspect aspect, QskControl* control )
 {
     /*
@@ -192,6 +173,20 @@ static inline void qskTriggerUpdates( QskAspect aspect, QskControl* control )
     }
 }
 
+static inline QskAspect qskQualifiedAspect(
+    const QskSkinnable* skinnable, QskAspect aspect )
+{
+    aspect.setSubControl( skinnable->effectiveSubcontrol( aspect.subControl() ) );
+
+    if ( aspect.section() == QskAspect::Body )
+        aspect.setSection( skinnable->section() );
+
+    if ( aspect.placement() == QskAspect::NoPlacement )
+        aspect.setPlacement( skinnable->effectivePlacement() );
+
+    return aspect;
+}
+
 static inline QskAspect qskSubstitutedAspect(
     const QskSkinnable* skinnable, QskAspect aspect )
 {
@@ -240,6 +235,110 @@ class QskSkinnable::PrivateData
     bool hasLocalSkinlet = false;
 };
 
+template< typename T >
+static inline T qskHintValue( const QVariant& hint )
+{
+    return hint.value< T >();
+}
+
+template<>
+inline QRgb qskHintValue< QRgb >( const QVariant& hint )
+{
+    return hint.value< QColor >().rgba();
+}
+
+/*
+    The types, that are stored in the typed arrays of a compact
+    QskSkinHintTable. The lookups are offered by the table as well
+    as by the hint cache of the skin.
+ */
+
+template< typename T >
+static constexpr bool qskIsTypedHint()
+{
+    return std::is_same< T, qreal >::value || std::is_same< T, QRgb >::value
+        || std::is_same< T, QskMargins >::value;
+}
+
+template< typename Table >
+static inline bool qskTypedHint( const Table& table,
+    QskAspect aspect, qreal& metric, QskAspect* resolvedAspect )
+{
+    return table.resolvedMetric( aspect, metric, resolvedAspect );
+}
+
+template< typename Table >
+static inline bool qskTypedHint( const Table& table,
+    QskAspect aspect, QRgb& rgb, QskAspect* resolvedAspect )
+{
+    return table.resolvedColor( aspect, rgb, resolvedAspect );
+}
+
+template< typename Table >
+static inline bool qskTypedHint( const Table& table,
+    QskAspect aspect, QskMargins& margins, QskAspect* resolvedAspect )
+{
+    return table.resolvedMargins( aspect, margins, resolvedAspect );
+}
+
+template< typename Table, typename T >
+static inline bool qskTypedHint( const Table&, QskAspect, T&, QskAspect* )
+{
+    return false;
+}
+
+template< typename T >
+inline T QskSkinnable::effectiveHintValue(
+    QskAspect aspect, QskSkinHintStatus* status ) const
+{
+    if ( m_data->animators.isEmpty() && !QskSkinTransition::isRunning() )
+    {
+        /*
+            Without any running animator the value has to be one of
+            the stored hints and we can convert it without creating
+            a temporary QVariant. Metrics, colors and margins are even
+            read without unwrapping a QVariant at all.
+         */
+
+        aspect = qskQualifiedAspect( this, aspect );
+
+        if ( !aspect.isAnimator() && !aspect.hasStates() )
+            aspect.setStates( skinStates() );
+
+        if ( qskIsTypedHint< T >() )
+        {
+            T value = T();
+            QskAspect resolvedAspect;
+
+            auto source = QskSkinHintStatus::NoSource;
+
+            const auto& localTable = m_data->hintTable;
+            if ( localTable.hasHints()
+                && qskTypedHint( localTable, aspect, value, &resolvedAspect ) )
+            {
+                source = QskSkinHintStatus::Skinnable;
+            }
+            else if ( qskTypedHint( effectiveSkin()->hintCache(),
+                aspect, value, &resolvedAspect ) )
+            {
+                source = QskSkinHintStatus::Skin;
+            }
+
+            if ( status )
+            {
+                status->source = source;
+                status->aspect = resolvedAspect;
+            }
+
+            return value;
+        }
+
+        return qskHintValue< T >( storedHint( aspect, status ) );
+    }
+
+    return qskHintValue< T >( effectiveSkinHint( aspect, status ) );
+}
+
 QskSkinnable::QskSkinnable()
     : m_data( new PrivateData() )
 {
@@ -309,6 +408,9 @@ void QskSkinnable::setSubcontrolProxy(
         m_data->subcontrolProxies = new PrivateData::ProxyMap();
 
     ( *m_data->subcontrolProxies )[ subControl ] = proxy;
+
+    if ( auto index = QskSubcontrolIndex::instance() )
+        index->invalidateTree( owningControl() );
 }
 
 void QskSkinnable::resetSubcontrolProxy( QskAspect::Subcontrol subcontrol )
@@ -324,6 +426,9 @@ void QskSkinnable::resetSubcontrolProxy( QskAspect::Subcontrol subcontrol )
                 delete proxies;
                 proxies = nullptr;
             }
+
+            if ( auto index = QskSubcontrolIndex::instance() )
+                index->invalidateTree( owningControl() );
         }
     }
 }
@@ -357,7 +462,7 @@ bool QskSkinnable::setFlagHint( const QskAspect aspect, int flag )
 
 int QskSkinnable::flagHint( const QskAspect aspect ) const
 {
-    return effectiveSkinHint( aspect ).toInt();
+    return effectiveHintValue< int >( aspect, nullptr );
 }
 
 bool QskSkinnable::setAlignmentHint( const QskAspect aspect, Qt::Alignment alignment )
@@ -402,7 +507,12 @@ bool QskSkinnable::moveColor( const QskAspect aspect, QRgb rgb )
 
 QColor QskSkinnable::color( const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskColor< QColor >( this, aspect, status );
+    return effectiveHintValue< QColor >( aspect | QskAspect::Color, status );
+}
+
+QRgb QskSkinnable::rgb( const QskAspect aspect, QskSkinHintStatus* status ) const
+{
+    return effectiveHintValue< QRgb >( aspect | QskAspect::Color, status );
 }
 
 bool QskSkinnable::setMetric( const QskAspect aspect, qreal metric )
@@ -417,7 +527,7 @@ bool QskSkinnable::moveMetric( QskAspect aspect, qreal metric )
 
 qreal QskSkinnable::metric( const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< qreal >( this, aspect, status );
+    return effectiveHintValue< qreal >( aspect | QskAspect::Metric, status );
 }
 
 bool QskSkinnable::setPositionHint( QskAspect aspect, qreal position )
@@ -443,7 +553,8 @@ bool QskSkinnable::resetPositionHint( QskAspect aspect )
 
 qreal QskSkinnable::positionHint( QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< qreal >( this, aspect | QskAspect::Position, status );
+    return effectiveHintValue< qreal >(
+        aspect | QskAspect::Position | QskAspect::Metric, status );
 }
 
 bool QskSkinnable::setStrutSizeHint(
@@ -465,7 +576,8 @@ bool QskSkinnable::resetStrutSizeHint( const QskAspect aspect )
 QSizeF QskSkinnable::strutSizeHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QSizeF >( this, aspect | QskAspect::StrutSize, status );
+    return effectiveHintValue< QSizeF >(
+        aspect | QskAspect::StrutSize | QskAspect::Metric, status );
 }
 
 bool QskSkinnable::setMarginHint( const QskAspect aspect, qreal margins )
@@ -486,7 +598,8 @@ bool QskSkinnable::resetMarginHint( const QskAspect aspect )
 QMarginsF QskSkinnable::marginHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskMargins >( this, aspect | QskAspect::Margin, status );
+    return effectiveHintValue< QskMargins >(
+        aspect | QskAspect::Margin | QskAspect::Metric, status );
 }
 
 bool QskSkinnable::setPaddingHint( const QskAspect aspect, qreal padding )
@@ -507,7 +620,8 @@ bool QskSkinnable::resetPaddingHint( const QskAspect aspect )
 QMarginsF QskSkinnable::paddingHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskMargins >( this, aspect | QskAspect::Padding, status );
+    return effectiveHintValue< QskMargins >(
+        aspect | QskAspect::Padding | QskAspect::Metric, status );
 }
 
 bool QskSkinnable::setGradientHint(
@@ -519,7 +633,7 @@ bool QskSkinnable::setGradientHint(
 QskGradient QskSkinnable::gradientHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskColor< QskGradient >( this, aspect, status );
+    return effectiveHintValue< QskGradient >( aspect | QskAspect::Color, status );
 }
 
 bool QskSkinnable::setBoxShapeHint(
@@ -536,8 +650,8 @@ bool QskSkinnable::resetBoxShapeHint( const QskAspect aspect )
 QskBoxShapeMetrics QskSkinnable::boxShapeHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskBoxShapeMetrics >(
-        this, aspect | QskAspect::Shape, status );
+    return effectiveHintValue< QskBoxShapeMetrics >(
+        aspect | QskAspect::Shape | QskAspect::Metric, status );
 }
 
 bool QskSkinnable::setBoxBorderMetricsHint(
@@ -554,8 +668,8 @@ bool QskSkinnable::resetBoxBorderMetricsHint( const QskAspect aspect )
 QskBoxBorderMetrics QskSkinnable::boxBorderMetricsHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskBoxBorderMetrics >(
-        this, aspect | QskAspect::Border, status );
+    return effectiveHintValue< QskBoxBorderMetrics >(
+        aspect | QskAspect::Border | QskAspect::Metric, status );
 }
 
 bool QskSkinnable::setBoxBorderColorsHint(
@@ -572,8 +686,8 @@ bool QskSkinnable::resetBoxBorderColorsHint( const QskAspect aspect )
 QskBoxBorderColors QskSkinnable::boxBorderColorsHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskColor< QskBoxBorderColors >(
-        this, aspect | QskAspect::Border, status );
+    return effectiveHintValue< QskBoxBorderColors >(
+        aspect | QskAspect::Border | QskAspect::Color, status );
 }
 
 bool QskSkinnable::setShadowMetricsHint(
@@ -590,8 +704,8 @@ bool QskSkinnable::resetShadowMetricsHint( QskAspect aspect )
 QskShadowMetrics QskSkinnable::shadowMetricsHint(
     QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskShadowMetrics >(
-        this, aspect | QskAspect::Shadow, status );
+    return effectiveHintValue< QskShadowMetrics >(
+        aspect | QskAspect::Shadow | QskAspect::Metric, status );
 }
 
 bool QskSkinnable::setShadowColorHint( QskAspect aspect, const QColor& color )
@@ -606,7 +720,8 @@ bool QskSkinnable::resetShadowColorHint( QskAspect aspect )
 
 QColor QskSkinnable::shadowColorHint( QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskColor< QColor >( this, aspect | QskAspect::Shadow, status );
+    return effectiveHintValue< QColor >(
+        aspect | QskAspect::Shadow | QskAspect::Color, status );
 }
 
 QskBoxHints QskSkinnable::boxHints( QskAspect aspect ) const
@@ -631,8 +746,8 @@ bool QskSkinnable::resetArcMetricsHint( const QskAspect aspect )
 QskArcMetrics QskSkinnable::arcMetricsHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskArcMetrics >(
-        this, aspect | QskAspect::Shape, status );
+    return effectiveHintValue< QskArcMetrics >(
+        aspect | QskAspect::Shape | QskAspect::Metric, status );
 }
 
 bool QskSkinnable::setSpacingHint( const QskAspect aspect, qreal spacing )
@@ -648,7 +763,8 @@ bool QskSkinnable::resetSpacingHint( const QskAspect aspect )
 qreal QskSkinnable::spacingHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< qreal >( this, aspect | QskAspect::Spacing, status );
+    return effectiveHintValue< qreal >(
+        aspect | QskAspect::Spacing | QskAspect::Metric, status );
 }
 
 bool QskSkinnable::setFontRoleHint( const QskAspect aspect, int role )
@@ -664,7 +780,8 @@ bool QskSkinnable::resetFontRoleHint( const QskAspect aspect )
 int QskSkinnable::fontRoleHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskFlag( this, aspect | QskAspect::FontRole, status );
+    return effectiveHintValue< int >(
+        aspect | QskAspect::FontRole | QskAspect::Flag, status );
 }
 
 QFont QskSkinnable::effectiveFont( const QskAspect aspect ) const
@@ -691,7 +808,8 @@ bool QskSkinnable::resetGraphicRoleHint( const QskAspect aspect )
 int QskSkinnable::graphicRoleHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskFlag( this, aspect | QskAspect::GraphicRole, status );
+    return effectiveHintValue< int >(
+        aspect | QskAspect::GraphicRole | QskAspect::Flag, status );
 }
 
 QskColorFilter QskSkinnable::effectiveGraphicFilter( QskAspect aspect ) const
@@ -836,13 +954,7 @@ bool QskSkinnable::resetSkinHint( QskAspect aspect )
 QVariant QskSkinnable::effectiveSkinHint(
     QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    aspect.setSubControl( effectiveSubcontrol( aspect.subControl() ) );
-
-    if ( aspect.section() == QskAspect::Body )
-        aspect.setSection( section() );
-
-    if ( aspect.placement() == QskAspect::NoPlacement )
-        aspect.setPlacement( effectivePlacement() );
+    aspect = qskQualifiedAspect( this, aspect );
 
     if ( aspect.isAnimator() )
         return storedHint( aspect, status );
@@ -923,32 +1035,8 @@ QVariant QskSkinnable::animatedValue(
                 if ( !aspect.hasStates() )
                     aspect.setStates( skinStates() );
 
-                const auto a = aspect;
-
-                Q_FOREVER
-                {
-                    v = QskSkinTransition::animatedHint( control->window(), aspect );
-
-                    if ( !v.isValid() )
-                    {
-                        if ( const auto topState = aspect.topState() )
-                        {
-                            aspect.clearState( aspect.topState() );
-                            continue;
-                        }
-
-                        if ( aspect.placement() )
-                        {
-                            // clear the placement bits and restart
-                            aspect = a;
-                            aspect.setPlacement( QskAspect::NoPlacement );
-
-                            continue;
-                        }
-                    }
-
-                    break;
-                }
+                v = QskSkinTransition::resolvedAnimatedHint(
+                    control->window(), aspect, &aspect );
             }
         }
     }
@@ -983,40 +1071,21 @@ const QVariant& QskSkinnable::storedHint(
         }
     }
 
-    // next we try the hints from the skin
+    /*
+        Next we try the hints from the skin. As the fallback chain
+        is the same for all skinnables of the skin the results are
+        memorized in the hint cache of the skin.
+     */
 
-    const auto& skinTable = skin->hintTable();
-    if ( skinTable.hasHints() )
+    if ( const auto value = skin->resolvedHint( aspect, &resolvedAspect ) )
     {
-        if ( const auto value = skinTable.resolvedHint( aspect, &resolvedAspect ) )
+        if ( status )
         {
-            if ( status )
-            {
-                status->source = QskSkinHintStatus::Skin;
-                status->aspect = resolvedAspect;
-            }
-
-            return *value;
+            status->source = QskSkinHintStatus::Skin;
+            status->aspect = resolvedAspect;
         }
 
-        if ( aspect.subControl() != QskAspect::Control )
-        {
-            // trying to resolve something from the skin default settings
-
-            aspect.setSubControl( QskAspect::Control );
-            aspect.clearStates();
-
-            if ( const auto value = skinTable.resolvedHint( aspect, &resolvedAspect ) )
-            {
-                if ( status )
-                {
-                    status->source = QskSkinHintStatus::Skin;
-                    status->aspect = resolvedAspect;
-                }
-
-                return *value;
-            }
-        }
+        return *value;
     }
 
     if ( status )
@@ -1173,6 +1242,11 @@ void QskSkinnable::startTransition( QskAspect aspect,
     startHintTransition( aspect, animationHint, from, to );
 }
 
+bool QskSkinnable::hasRunningTransitions() const
+{
+    return !m_data->animators.isEmpty() || QskSkinTransition::isRunning();
+}
+
 void QskSkinnable::startHintTransition( QskAspect aspect,
     QskAnimationHint animationHint, const QVariant& from, const QVariant& to )
 {
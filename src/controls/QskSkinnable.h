@@ -124,6 +124,9 @@ class QSK_EXPORT QskSkinnable
     void startTransition( QskAspect,
         QskAnimationHint, const QVariant& from, const QVariant& to );
 
+    // true, when effective hints might differ from the stored ones
+    bool hasRunningTransitions() const;
+
     QskAspect::Subcontrol effectiveSubcontrol( QskAspect::Subcontrol ) const;
 
     QskControl* controlCast();
@@ -163,6 +166,7 @@ class QSK_EXPORT QskSkinnable
 
     bool resetColor( QskAspect );
     QColor color( QskAspect, QskSkinHintStatus* = nullptr ) const;
+    QRgb rgb( QskAspect, QskSkinHintStatus* = nullptr ) const;
 
     bool setMetric( QskAspect, qreal );
     bool moveMetric( QskAspect, qreal );
@@ -260,6 +264,9 @@ class QSK_EXPORT QskSkinnable
     QVariant animatedValue( QskAspect, QskSkinHintStatus* ) const;
     const QVariant& storedHint( QskAspect, QskSkinHintStatus* = nullptr ) const;
 
+    template< typename T >
+    T effectiveHintValue( QskAspect, QskSkinHintStatus* ) const;
+
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
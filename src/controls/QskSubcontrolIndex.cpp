@@ -0,0 +1,177 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskSubcontrolIndex.h"
+#include "QskControl.h"
+
+#include <qglobalstatic.h>
+#include <qhash.h>
+#include <qquickitem.h>
+#include <qset.h>
+
+class QskSubcontrolIndex::PrivateData
+{
+  public:
+    void add( QskControl* control )
+    {
+        auto subControls = control->subControls();
+
+        if ( control->autoFillBackground() )
+        {
+            if ( !subControls.contains( QskAspect::Control ) )
+                subControls += QskAspect::Control;
+        }
+
+        for ( const auto subControl : subControls )
+            controls[ subControl ].insert( control );
+
+        resolved.insert( control, subControls );
+    }
+
+    bool take( QskControl* control )
+    {
+        auto it = resolved.find( control );
+        if ( it == resolved.end() )
+            return false;
+
+        for ( const auto subControl : qAsConst( it.value() ) )
+        {
+            auto itControls = controls.find( subControl );
+            if ( itControls != controls.end() )
+            {
+                itControls->remove( control );
+                if ( itControls->isEmpty() )
+                    controls.erase( itControls );
+            }
+        }
+
+        resolved.erase( it );
+        return true;
+    }
+
+    // registered, but the subcontrols are not known yet
+    QSet< QskControl* > pending;
+
+    // the subcontrols of a control, needed for removing it
+    QHash< QskControl*, QVector< QskAspect::Subcontrol > > resolved;
+
+    QHash< quint16, QSet< QskControl* > > controls;
+};
+
+QskSubcontrolIndex::QskSubcontrolIndex()
+    : m_data( new PrivateData() )
+{
+}
+
+QskSubcontrolIndex::~QskSubcontrolIndex()
+{
+}
+
+Q_GLOBAL_STATIC( QskSubcontrolIndex, qskSubcontrolIndex )
+
+QskSubcontrolIndex* QskSubcontrolIndex::instance()
+{
+    return qskSubcontrolIndex;
+}
+
+void QskSubcontrolIndex::insert( QskControl* control )
+{
+    if ( control && !m_data->resolved.contains( control ) )
+        m_data->pending.insert( control );
+}
+
+void QskSubcontrolIndex::remove( QskControl* control )
+{
+    /*
+        Called from the destructor, where the control has
+        already lost its derived classes. So we must not
+        ask the control for its subcontrols.
+     */
+    if ( !m_data->pending.remove( control ) )
+        m_data->take( control );
+}
+
+void QskSubcontrolIndex::invalidate( QskControl* control )
+{
+    if ( m_data->take( control ) )
+        m_data->pending.insert( control );
+}
+
+static void qskInvalidateChildren( QskSubcontrolIndex* index, const QQuickItem* item )
+{
+    const auto children = item->childItems();
+
+    for ( auto child : children )
+    {
+        if ( auto control = qskControlCast( child ) )
+            index->invalidate( control );
+
+        qskInvalidateChildren( index, child );
+    }
+}
+
+void QskSubcontrolIndex::invalidateTree( QskControl* control )
+{
+    if ( control )
+    {
+        invalidate( control );
+        qskInvalidateChildren( this, control );
+    }
+}
+
+void QskSubcontrolIndex::resolve() const
+{
+    if ( m_data->pending.isEmpty() )
+        return;
+
+    for ( auto control : qAsConst( m_data->pending ) )
+        m_data->add( control );
+
+    m_data->pending.clear();
+}
+
+QVector< QskControl* > QskSubcontrolIndex::controls(
+    const QVector< QskAspect::Subcontrol >& subControls ) const
+{
+    resolve();
+
+    QSet< QskControl* > controls;
+
+    for ( const auto subControl : subControls )
+    {
+        auto it = m_data->controls.constFind( subControl );
+        if ( it != m_data->controls.constEnd() )
+            controls.unite( it.value() );
+    }
+
+    return QVector< QskControl* >( controls.cbegin(), controls.cend() );
+}
+
+QVector< QskControl* > QskSubcontrolIndex::controls(
+    QskAspect::Subcontrol subControl ) const
+{
+    resolve();
+
+    const auto controls = m_data->controls.value( subControl );
+    return QVector< QskControl* >( controls.cbegin(), controls.cend() );
+}
+
+QVector< QskControl* > QskSubcontrolIndex::controls() const
+{
+    resolve();
+
+    QVector< QskControl* > controls;
+    controls.reserve( m_data->resolved.count() );
+
+    for ( auto it = m_data->resolved.constBegin(); it != m_data->resolved.constEnd(); ++it )
+        controls += it.key();
+
+    return controls;
+}
+
+int QskSubcontrolIndex::count() const
+{
+    return m_data->pending.count() + m_data->resolved.count();
+}
@@ -0,0 +1,73 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_SUBCONTROL_INDEX_H
+#define QSK_SUBCONTROL_INDEX_H
+
+#include "QskAspect.h"
+
+#include <qvector.h>
+#include <memory>
+
+class QskControl;
+
+/*
+    QskSubcontrolIndex is a reverse index from subcontrols to the
+    live controls, that are made of them. It allows to find the controls,
+    that are affected by changes of skin hints, without walking
+    through the item trees of all windows.
+
+    Controls are registered, when being created. As the subcontrols
+    of a control depend on its final class and its subcontrol proxies,
+    they are resolved lazily when the index is queried and resolved
+    again, whenever a proxy is modified.
+
+    Modifying a proxy invalidates the children of the control as well,
+    as they might map their subcontrols through the proxies of
+    their parent - like the buttons of QskVirtualKeyboard.
+    Controls, that substitute subcontrols depending on any other state,
+    need to call invalidate(), when the substitution changes.
+
+    QskAspect::Control is considered to be a subcontrol of the controls,
+    that fill their background.
+
+    The index is not thread safe and has to be used from the GUI thread.
+ */
+class QSK_EXPORT QskSubcontrolIndex
+{
+  public:
+    QskSubcontrolIndex();
+    ~QskSubcontrolIndex();
+
+    // nullptr, when the application is shutting down
+    static QskSubcontrolIndex* instance();
+
+    void insert( QskControl* );
+    void remove( QskControl* );
+
+    // the subcontrols of the control have to be resolved again
+    void invalidate( QskControl* );
+
+    // the same for the control and all controls below
+    void invalidateTree( QskControl* );
+
+    // all controls, that have at least one of the subcontrols
+    QVector< QskControl* > controls( const QVector< QskAspect::Subcontrol >& ) const;
+    QVector< QskControl* > controls( QskAspect::Subcontrol ) const;
+
+    QVector< QskControl* > controls() const;
+
+    int count() const;
+
+  private:
+    Q_DISABLE_COPY( QskSubcontrolIndex )
+
+    void resolve() const;
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
@@ -6,13 +6,20 @@
 #include "QskWindow.h"
 #include "QskControl.h"
 #include "QskEvent.h"
+#include "QskFrameStatistics.h"
 #include "QskQuick.h"
 #include "QskSetup.h"
 #include "QskSkin.h"
 #include "QskSkinManager.h"
+#include "QskTextLabel.h"
+#include "QskTextOptions.h"
+#include "QskTextRenderer.h"
 
+#include <qfontmetrics.h>
 #include <qmath.h>
 #include <qpointer.h>
+#include <qset.h>
+#include <qstringlist.h>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qquickitem_p.h>
@@ -96,6 +103,89 @@ namespace
     };
 }
 
+namespace
+{
+    class TextGroup
+    {
+      public:
+        QFont font;
+        QskTextOptions options;
+        QSizeF size; // invalid: unconstrained
+        QStringList texts;
+    };
+}
+
+static void qskAddText( const QString& text, const QFont& font,
+    const QskTextOptions& options, const QSizeF& size, QVector< TextGroup >& groups )
+{
+    for ( auto& group : groups )
+    {
+        if ( group.size == size && group.options == options && group.font == font )
+        {
+            group.texts += text;
+            return;
+        }
+    }
+
+    TextGroup group;
+    group.font = font;
+    group.options = options;
+    group.size = size;
+    group.texts += text;
+
+    groups += group;
+}
+
+static void qskCollectTexts( const QQuickItem* item, QVector< TextGroup >& groups )
+{
+    const auto children = item->childItems();
+    for ( const auto child : children )
+    {
+        if ( !child->isVisible() )
+            continue;
+
+        if ( auto label = qobject_cast< const QskTextLabel* >( child ) )
+        {
+            const auto text = label->text();
+
+            if ( !text.isEmpty() )
+            {
+                // see QskTextLabelSkinlet::sizeHint
+                const auto font = label->effectiveFont( QskTextLabel::Text );
+
+                auto options = label->textOptions();
+                options.setFormat( label->effectiveTextFormat() );
+
+                qskAddText( text, font, options, QSizeF(), groups );
+
+                if ( label->sizePolicy().isConstrained( Qt::Vertical )
+                    && options.effectiveElideMode() == Qt::ElideNone
+                    && label->width() > 0.0 )
+                {
+                    /*
+                        The height for width hint. As the layout usually
+                        keeps the width of the label we prepare
+                        the size for the current one.
+                     */
+                    const qreal lineHeight = QFontMetricsF( font ).height();
+
+                    qreal maxHeight = std::numeric_limits< qreal >::max();
+                    if ( maxHeight / lineHeight > options.maximumLineCount() )
+                    {
+                        // be careful with overflows
+                        maxHeight = options.maximumLineCount() * lineHeight;
+                    }
+
+                    qskAddText( text, font, options,
+                        QSizeF( label->width(), maxHeight ), groups );
+                }
+            }
+        }
+
+        qskCollectTexts( child, groups );
+    }
+}
+
 static inline int qskToIntegerConstraint( qreal valueF )
 {
     int value = -1;
@@ -143,6 +233,7 @@ class QskWindowPrivate : public QQuickWindowPrivate
         , explicitLocale( false )
         , deleteOnClose( false )
         , autoLayoutChildren( true )
+        , parallelPolish( false )
     {
     }
 
@@ -152,6 +243,8 @@ class QskWindowPrivate : public QQuickWindowPrivate
 
     QPointer< QskSkin > skin;
 
+    std::unique_ptr< QskFrameRecorder > frameRecorder;
+
     ChildListener contentItemListener;
     QLocale locale;
 
@@ -163,6 +256,7 @@ class QskWindowPrivate : public QQuickWindowPrivate
     bool explicitLocale : 1;
     bool deleteOnClose : 1;
     bool autoLayoutChildren : 1;
+    bool parallelPolish : 1;
 };
 
 QskWindow::QskWindow( QWindow* parent )
@@ -282,9 +376,73 @@ void QskWindow::addItem( QQuickItem* item )
 void QskWindow::polishItems()
 {
     Q_D( QskWindow );
+
+    if ( d->parallelPolish )
+        preparePolish();
+
     d->polishItems();
 }
 
+void QskWindow::setParallelPolish( bool on )
+{
+    Q_D( QskWindow );
+
+    if ( on != d->parallelPolish )
+    {
+        d->parallelPolish = on;
+        Q_EMIT parallelPolishChanged( on );
+    }
+}
+
+bool QskWindow::parallelPolish() const
+{
+    Q_D( const QskWindow );
+    return d->parallelPolish;
+}
+
+void QskWindow::preparePolish()
+{
+    Q_D( QskWindow );
+
+    const auto items = d->itemsToPolish;
+    if ( items.isEmpty() )
+        return;
+
+    QSet< const QQuickItem* > polishedItems;
+    for ( const auto item : items )
+        polishedItems += item;
+
+    /*
+        Measuring texts is the expensive and thread safe part
+        of the size hint calculations. All other parts depend on skin hints,
+        animators and other state, that is not safe outside of the GUI thread.
+     */
+    QVector< TextGroup > groups;
+
+    for ( const auto item : items )
+    {
+        bool isNested = false;
+
+        for ( auto p = item->parentItem(); p != nullptr; p = p->parentItem() )
+        {
+            if ( polishedItems.contains( p ) )
+            {
+                isNested = true;
+                break;
+            }
+        }
+
+        if ( !isNested )
+            qskCollectTexts( item, groups );
+    }
+
+    for ( const auto& group : groups )
+    {
+        QskTextRenderer::prepareTextSizes(
+            group.texts, group.font, group.options, group.size );
+    }
+}
+
 bool QskWindow::event( QEvent* event )
 {
     /*
@@ -339,6 +497,15 @@ bool QskWindow::event( QEvent* event )
         }
         case QEvent::UpdateRequest:
         {
+            /*
+                The render loops polish the items, when QQuickWindow
+                handles the update request - afterAnimating is emitted
+                later. As QQuickWindowPrivate::polishItems() is not
+                virtual, we have to prepare before.
+             */
+            if ( d->parallelPolish )
+                preparePolish();
+
 #ifdef QSK_DEBUG_RENDER_TIMING
             if ( logTiming().isDebugEnabled() )
             {
@@ -677,4 +844,63 @@ QskSkin* qskEffectiveSkin( const QQuickWindow* window )
     return qskSetup->skin();
 }
 
+void QskWindow::setFrameStatisticsCapacity( int capacity )
+{
+    Q_D( QskWindow );
+
+    capacity = qMax( capacity, 0 );
+
+    if ( capacity == frameStatisticsCapacity() )
+        return;
+
+    if ( capacity == 0 )
+    {
+        d->frameRecorder.reset();
+    }
+    else
+    {
+        if ( d->frameRecorder == nullptr )
+            d->frameRecorder.reset( new QskFrameRecorder( this ) );
+
+        d->frameRecorder->setCapacity( capacity );
+    }
+
+    Q_EMIT frameStatisticsCapacityChanged( capacity );
+}
+
+int QskWindow::frameStatisticsCapacity() const
+{
+    Q_D( const QskWindow );
+    return d->frameRecorder ? d->frameRecorder->capacity() : 0;
+}
+
+QVector< QskFrameStatistics > QskWindow::frameStatistics() const
+{
+    Q_D( const QskWindow );
+
+    if ( d->frameRecorder )
+        return d->frameRecorder->frames();
+
+    return QVector< QskFrameStatistics >();
+}
+
+QVariantList QskWindow::frameStatisticsList() const
+{
+    const auto frames = frameStatistics();
+
+    QVariantList list;
+    list.reserve( frames.count() );
+
+    for ( const auto& frame : frames )
+        list += QVariant::fromValue( frame );
+
+    return list;
+}
+
+bool QskWindow::dumpFrameStatistics( const QString& fileName ) const
+{
+    Q_D( const QskWindow );
+    return d->frameRecorder && d->frameRecorder->dump( fileName );
+}
+
 #include "moc_QskWindow.cpp"
@@ -8,10 +8,12 @@
 
 #include "QskGlobal.h"
 #include <qquickwindow.h>
+#include <qvector.h>
 
 class QskWindowPrivate;
 class QskObjectAttributes;
 class QskSkin;
+class QskFrameStatistics;
 
 class QSK_EXPORT QskWindow : public QQuickWindow
 {
@@ -26,6 +28,12 @@ class QSK_EXPORT QskWindow : public QQuickWindow
     Q_PROPERTY( QLocale locale READ locale
         WRITE setLocale RESET resetLocale NOTIFY localeChanged FINAL )
 
+    Q_PROPERTY( int frameStatisticsCapacity READ frameStatisticsCapacity
+        WRITE setFrameStatisticsCapacity NOTIFY frameStatisticsCapacityChanged FINAL )
+
+    Q_PROPERTY( bool parallelPolish READ parallelPolish
+        WRITE setParallelPolish NOTIFY parallelPolishChanged FINAL )
+
     using Inherited = QQuickWindow;
 
   public:
@@ -63,6 +71,16 @@ class QSK_EXPORT QskWindow : public QQuickWindow
 
     void polishItems();
 
+    /*
+        Before polishing, the texts of the labels, that are going to be
+        laid out, are measured in parallel: unconstrained and for
+        the current width of labels with height for width hints.
+        The results are cached, so that the size hints, that are
+        calculated when polishing, are the same as without preparation.
+     */
+    void setParallelPolish( bool );
+    bool parallelPolish() const;
+
     void setCustomRenderMode( const char* mode );
     const char* customRenderMode() const;
 
@@ -75,10 +93,25 @@ class QSK_EXPORT QskWindow : public QQuickWindow
     void setSkin( const QString& );
     QskSkin* skin() const;
 
+    /*
+        Recording the statistics of the last frames. A capacity
+        of 0 - the default - disables the recording.
+     */
+    void setFrameStatisticsCapacity( int );
+    int frameStatisticsCapacity() const;
+
+    // the oldest frame first
+    QVector< QskFrameStatistics > frameStatistics() const;
+
+    Q_INVOKABLE QVariantList frameStatisticsList() const;
+    Q_INVOKABLE bool dumpFrameStatistics( const QString& fileName ) const;
+
   Q_SIGNALS:
     void localeChanged( const QLocale& );
     void autoLayoutChildrenChanged();
     void deleteOnCloseChanged();
+    void frameStatisticsCapacityChanged( int );
+    void parallelPolishChanged( bool );
 
   public Q_SLOTS:
     void setLocale( const QLocale& );
@@ -96,6 +129,7 @@ class QSK_EXPORT QskWindow : public QQuickWindow
 
   private:
     void enforceSkin();
+    void preparePolish();
 
     Q_DECLARE_PRIVATE( QskWindow )
 };
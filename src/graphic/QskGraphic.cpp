@@ -5,6 +5,7 @@
 
 #include "QskGraphic.h"
 #include "QskColorFilter.h"
+#include "QskGraphicMapping.h"
 #include "QskGraphicPaintEngine.h"
 #include "QskPainterCommand.h"
 
@@ -69,6 +70,29 @@ static QRectF qskStrokedPathRect(
     return rect;
 }
 
+static inline bool qskMapsPath(
+    const QPainter* painter, QskGraphic::RenderHints renderHints )
+{
+    bool doMap = false;
+
+    if ( painter->transform().isScaling() )
+    {
+        if ( painter->pen().isCosmetic() )
+        {
+            // OpenGL2 seems to be buggy for cosmetic pens.
+            // It interpolates curves in too rough steps then
+
+            doMap = painter->paintEngine()->type() == QPaintEngine::OpenGL2;
+        }
+        else
+        {
+            doMap = renderHints.testFlag( QskGraphic::RenderPensUnscaled );
+        }
+    }
+
+    return doMap;
+}
+
 static inline void qskExecCommand(
     QPainter* painter, const QskPainterCommand& cmd,
     const QskColorFilter& colorFilter,
@@ -80,24 +104,7 @@ static inline void qskExecCommand(
     {
         case QskPainterCommand::Path:
         {
-            bool doMap = false;
-
-            if ( painter->transform().isScaling() )
-            {
-                if ( painter->pen().isCosmetic() )
-                {
-                    // OpenGL2 seems to be buggy for cosmetic pens.
-                    // It interpolates curves in too rough steps then
-
-                    doMap = painter->paintEngine()->type() == QPaintEngine::OpenGL2;
-                }
-                else
-                {
-                    doMap = renderHints.testFlag( QskGraphic::RenderPensUnscaled );
-                }
-            }
-
-            if ( doMap )
+            if ( qskMapsPath( painter, renderHints ) )
             {
                 const QTransform tr = painter->transform();
 
@@ -256,6 +263,10 @@ namespace QskGraphicPrivate
             return rect;
         }
 
+        inline QRectF pointRect() const { return m_pointRect; }
+        inline QRectF boundingRect() const { return m_boundingRect; }
+        inline bool isScalablePen() const { return m_scalablePen; }
+
         inline double scaleFactorX( const QRectF& pathRect,
             const QRectF& targetRect, bool scalePens ) const
         {
@@ -338,6 +349,7 @@ class QskGraphic::PrivateData : public QSharedData
         : QSharedData( other )
         , defaultSize( other.defaultSize )
         , commands( other.commands )
+        , mapping( other.mapping )
         , pathInfos( other.pathInfos )
         , boundingRect( other.boundingRect )
         , pointRect( other.pointRect )
@@ -356,14 +368,29 @@ class QskGraphic::PrivateData : public QSharedData
 
     inline void addCommand( const QskPainterCommand& command )
     {
+        if ( mapping.isValid() )
+        {
+            // no more rendering from the mapped memory
+            commands = mapping.commands();
+            mapping = QskGraphicMapping();
+        }
+
         commands += command;
+        modificationId = nextModificationId();
+    }
 
+    static inline quint64 nextModificationId()
+    {
         static QAtomicInteger< quint64 > nextId( 1 );
-        modificationId = nextId.fetchAndAddRelaxed( 1 );
+        return nextId.fetchAndAddRelaxed( 1 );
     }
 
     QSizeF defaultSize;
     QVector< QskPainterCommand > commands;
+
+    // commands, that are rendered from the memory of a mapped file
+    QskGraphicMapping mapping;
+
     QVector< QskGraphicPrivate::PathInfo > pathInfos;
 
     QRectF boundingRect = { 0.0, 0.0, -1.0, -1.0 };
@@ -490,6 +517,7 @@ int QskGraphic::metric( PaintDeviceMetric deviceMetric ) const
 void QskGraphic::reset()
 {
     m_data->commands.clear();
+    m_data->mapping = QskGraphicMapping();
     m_data->pathInfos.clear();
 
     m_data->commandTypes = 0;
@@ -506,7 +534,7 @@ void QskGraphic::reset()
 
 bool QskGraphic::isNull() const
 {
-    return m_data->commands.isEmpty();
+    return m_data->commands.isEmpty() && !m_data->mapping.isValid();
 }
 
 bool QskGraphic::isEmpty() const
@@ -631,18 +659,41 @@ void QskGraphic::render( QPainter* painter,
     if ( isNull() )
         return;
 
-    const int numCommands = m_data->commands.size();
-    const auto commands = m_data->commands.constData();
-
     const auto transform = painter->transform();
     const QskGraphic::RenderHints renderHints( m_data->renderHints );
 
     painter->save();
 
-    for ( int i = 0; i < numCommands; i++ )
+    if ( m_data->mapping.isValid() )
     {
-        qskExecCommand( painter, commands[ i ], colorFilter,
-            renderHints, transform, initialTransform );
+        const auto& mapping = m_data->mapping;
+        const int numCommands = mapping.commandCount();
+
+        for ( int i = 0; i < numCommands; i++ )
+        {
+            if ( const auto command = mapping.command( i ) )
+            {
+                qskExecCommand( painter, *command, colorFilter,
+                    renderHints, transform, initialTransform );
+            }
+            else if ( qskMapsPath( painter, renderHints )
+                || !mapping.drawPath( painter, i ) )
+            {
+                qskExecCommand( painter, QskPainterCommand( mapping.path( i ) ),
+                    colorFilter, renderHints, transform, initialTransform );
+            }
+        }
+    }
+    else
+    {
+        const int numCommands = m_data->commands.size();
+        const auto commands = m_data->commands.constData();
+
+        for ( int i = 0; i < numCommands; i++ )
+        {
+            qskExecCommand( painter, commands[ i ], colorFilter,
+                renderHints, transform, initialTransform );
+        }
     }
 
     painter->restore();
@@ -978,6 +1029,9 @@ void QskGraphic::updateControlPointRect( const QRectF& rect )
 
 const QVector< QskPainterCommand >& QskGraphic::commands() const
 {
+    if ( m_data->mapping.isValid() )
+        return m_data->mapping.commands();
+
     return m_data->commands;
 }
 
@@ -1008,6 +1062,59 @@ void QskGraphic::setCommands( const QVector< QskPainterCommand >& commands )
     painter.end();
 }
 
+void QskGraphic::setMapping( const QskGraphicMapping& mapping )
+{
+    reset();
+
+    if ( mapping.commandCount() <= 0 )
+        return;
+
+    /*
+        The geometry has been calculated, when writing the mapping.
+        So there is no need to replay the commands like in setCommands.
+     */
+
+    m_data->mapping = mapping;
+    m_data->commandTypes = mapping.commandTypes();
+
+    if ( !mapping.boundingRect().isNull() )
+        m_data->boundingRect = mapping.boundingRect();
+
+    if ( !mapping.controlPointRect().isNull() )
+        m_data->pointRect = mapping.controlPointRect();
+
+    const int count = mapping.pathInfoCount();
+    m_data->pathInfos.reserve( count );
+
+    for ( int i = 0; i < count; i++ )
+    {
+        QRectF pointRect, boundingRect;
+        bool scalablePen;
+
+        mapping.pathInfo( i, pointRect, boundingRect, scalablePen );
+
+        m_data->pathInfos += QskGraphicPrivate::PathInfo(
+            pointRect, boundingRect, scalablePen );
+    }
+
+    m_data->modificationId = PrivateData::nextModificationId();
+}
+
+int QskGraphic::pathInfoCount() const
+{
+    return m_data->pathInfos.count();
+}
+
+void QskGraphic::pathInfo( int index, QRectF& pointRect,
+    QRectF& boundingRect, bool& scalablePen ) const
+{
+    const auto& info = m_data->pathInfos[ index ];
+
+    pointRect = info.pointRect();
+    boundingRect = info.boundingRect();
+    scalablePen = info.isScalablePen();
+}
+
 quint64 QskGraphic::modificationId() const
 {
     return m_data->modificationId;
@@ -14,6 +14,7 @@
 #include <qshareddata.h>
 
 class QskPainterCommand;
+class QskGraphicMapping;
 class QskColorFilter;
 class QskGraphicPaintEngine;
 class QImage;
@@ -147,6 +148,14 @@ class QSK_EXPORT QskGraphic : public QPaintDevice
     void updateBoundingRect( const QRectF& );
     void updateControlPointRect( const QRectF& );
 
+    friend class QskGraphicMapping;
+
+    void setMapping( const QskGraphicMapping& );
+
+    int pathInfoCount() const;
+    void pathInfo( int index, QRectF& pointRect,
+        QRectF& boundingRect, bool& scalablePen ) const;
+
     class PrivateData;
     QSharedDataPointer< PrivateData > m_data;
 
@@ -5,6 +5,7 @@
 
 #include "QskGraphicIO.h"
 #include "QskGraphic.h"
+#include "QskGraphicMapping.h"
 #include "QskPainterCommand.h"
 
 #include <qbuffer.h>
@@ -30,13 +31,12 @@ static inline void qskWritePathData(
     s << path;
 }
 
-static inline void qskReadPathData(
-    QDataStream& s, QVector< QskPainterCommand >& commands )
+static inline QskPainterCommand qskReadPathData( QDataStream& s )
 {
     QPainterPath path;
     s >> path;
 
-    commands += QskPainterCommand( path );
+    return QskPainterCommand( path );
 }
 
 static inline void qskWritePixmapData(
@@ -45,8 +45,7 @@ static inline void qskWritePixmapData(
     s << data.rect << data.pixmap << data.subRect;
 }
 
-static inline void qskReadPixmapData(
-    QDataStream& s, QVector< QskPainterCommand >& commands )
+static inline QskPainterCommand qskReadPixmapData( QDataStream& s )
 {
     QskPainterCommand::PixmapData data;
 
@@ -54,7 +53,7 @@ static inline void qskReadPixmapData(
     s >> data.pixmap;
     s >> data.subRect;
 
-    commands += QskPainterCommand( data.rect, data.pixmap, data.subRect );
+    return QskPainterCommand( data.rect, data.pixmap, data.subRect );
 }
 
 static inline void qskWriteImageData(
@@ -63,8 +62,7 @@ static inline void qskWriteImageData(
     s << data.rect << data.image << data.subRect;
 }
 
-static inline void qskReadImageData(
-    QDataStream& s, QVector< QskPainterCommand >& commands )
+static inline QskPainterCommand qskReadImageData( QDataStream& s )
 {
     QskPainterCommand::ImageData data;
 
@@ -76,7 +74,7 @@ static inline void qskReadImageData(
     s >> flags;
     data.flags = static_cast< Qt::ImageConversionFlags >( flags );
 
-    commands += QskPainterCommand( data.rect, data.image, data.subRect, data.flags );
+    return QskPainterCommand( data.rect, data.image, data.subRect, data.flags );
 }
 
 static inline void qskWriteStateData(
@@ -130,8 +128,7 @@ static inline void qskWriteStateData(
         s << data.opacity;
 }
 
-static inline void qskReadStateData(
-    QDataStream& s, QVector< QskPainterCommand >& commands )
+static inline QskPainterCommand qskReadStateData( QDataStream& s )
 {
     QskPainterCommand::StateData data;
 
@@ -200,7 +197,72 @@ static inline void qskReadStateData(
     if ( data.flags & QPaintEngine::DirtyOpacity )
         s >> data.opacity;
 
-    commands += QskPainterCommand( data );
+    return QskPainterCommand( data );
+}
+
+static QskPainterCommand qskReadCommand( QDataStream& s )
+{
+    quint8 type = 0xff;
+    s >> type;
+
+    switch ( type )
+    {
+        case QskPainterCommand::Path:
+            return qskReadPathData( s );
+
+        case QskPainterCommand::Pixmap:
+            return qskReadPixmapData( s );
+
+        case QskPainterCommand::Image:
+            return qskReadImageData( s );
+
+        case QskPainterCommand::State:
+            return qskReadStateData( s );
+
+        default:
+            return QskPainterCommand();
+    }
+}
+
+static bool qskWriteCommand( const QskPainterCommand& command, QDataStream& s )
+{
+    s << static_cast< quint8 >( command.type() );
+
+    switch ( command.type() )
+    {
+        case QskPainterCommand::Path:
+        {
+            qskWritePathData( *command.path(), s );
+            break;
+        }
+        case QskPainterCommand::Pixmap:
+        {
+            qskWritePixmapData( *command.pixmapData(), s );
+            break;
+        }
+        case QskPainterCommand::Image:
+        {
+            qskWriteImageData( *command.imageData(), s );
+            break;
+        }
+        case QskPainterCommand::State:
+        {
+            qskWriteStateData( *command.stateData(), s );
+            break;
+        }
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+static inline void qskInitStream( QDataStream& stream )
+{
+#if 1
+    stream.setVersion( qskDataStreamVersion );
+#endif
+    stream.setByteOrder( QDataStream::BigEndian );
 }
 
 QskGraphic QskGraphicIO::read( const QString& fileName )
@@ -212,13 +274,23 @@ QskGraphic QskGraphicIO::read( const QString& fileName )
         return QskGraphic();
     }
 
+    if ( QskGraphicMapping::canRead( file.peek( 4 ) ) )
+    {
+        file.close();
+        return QskGraphicMapping::map( fileName ).toGraphic();
+    }
+
     return read( &file );
 }
 
 QskGraphic QskGraphicIO::read( const QByteArray& data )
 {
+    if ( QskGraphicMapping::canRead( data ) )
+        return QskGraphicMapping::fromData( data ).toGraphic();
+
     QBuffer buffer;
     buffer.setData( data );
+    buffer.open( QIODevice::ReadOnly );
 
     return read( &buffer );
 }
@@ -228,11 +300,11 @@ QskGraphic QskGraphicIO::read( QIODevice* dev )
     if ( dev == nullptr )
         return QskGraphic();
 
+    if ( QskGraphicMapping::canRead( dev->peek( 4 ) ) )
+        return QskGraphicMapping::fromData( dev->readAll() ).toGraphic();
+
     QDataStream stream( dev );
-#if 1
-    stream.setVersion( qskDataStreamVersion );
-#endif
-    stream.setByteOrder( QDataStream::BigEndian );
+    qskInitStream( stream );
 
     char magicNumber[ 4 ];
     stream.readRawData( magicNumber, 4 );
@@ -250,34 +322,11 @@ QskGraphic QskGraphicIO::read( QIODevice* dev )
 
     for ( uint i = 0; i < numCommands; i++ )
     {
-        quint8 type;
-        stream >> type;
+        const auto command = qskReadCommand( stream );
+        if ( command.type() == QskPainterCommand::Invalid )
+            return QskGraphic();
 
-        switch ( type )
-        {
-            case QskPainterCommand::Path:
-            {
-                qskReadPathData( stream, commands );
-                break;
-            }
-            case QskPainterCommand::Pixmap:
-            {
-                qskReadPixmapData( stream, commands );
-                break;
-            }
-            case QskPainterCommand::Image:
-            {
-                qskReadImageData( stream, commands );
-                break;
-            }
-            case QskPainterCommand::State:
-            {
-                qskReadStateData( stream, commands );
-                break;
-            }
-            default:
-                return QskGraphic();
-        }
+        commands += command;
     }
 
     QskGraphic graphic;
@@ -286,7 +335,16 @@ QskGraphic QskGraphicIO::read( QIODevice* dev )
     return graphic;
 }
 
-bool QskGraphicIO::write( const QskGraphic& graphic, const QString& fileName )
+QskPainterCommand QskGraphicIO::readCommand( const QByteArray& data )
+{
+    QDataStream stream( data );
+    qskInitStream( stream );
+
+    return qskReadCommand( stream );
+}
+
+bool QskGraphicIO::write( const QskGraphic& graphic,
+    const QString& fileName, Format format )
 {
     QFile file( fileName );
     if ( file.open( QIODevice::WriteOnly | QIODevice::Truncate ) == false )
@@ -295,25 +353,37 @@ bool QskGraphicIO::write( const QskGraphic& graphic, const QString& fileName )
         return false;
     }
 
-    return write( graphic, &file );
+    return write( graphic, &file, format );
 }
 
-bool QskGraphicIO::write( const QskGraphic& graphic, QByteArray& data )
+bool QskGraphicIO::write( const QskGraphic& graphic,
+    QByteArray& data, Format format )
 {
     QBuffer buffer( &data );
-    return write( graphic, &buffer );
+    if ( buffer.open( QIODevice::WriteOnly ) == false )
+        return false;
+
+    return write( graphic, &buffer, format );
 }
 
-bool QskGraphicIO::write( const QskGraphic& graphic, QIODevice* dev )
+bool QskGraphicIO::write( const QskGraphic& graphic,
+    QIODevice* dev, Format format )
 {
     if ( dev == nullptr )
         return false;
 
+    if ( format == Mapped )
+    {
+        const auto data = QskGraphicMapping::toData( graphic );
+        if ( data.isEmpty() )
+            return false;
+
+        return dev->write( data ) == data.size();
+    }
+
     QDataStream stream( dev );
-#if 1
-    stream.setVersion( qskDataStreamVersion );
-#endif
-    stream.setByteOrder( QDataStream::BigEndian );
+    qskInitStream( stream );
+
     stream.writeRawData( qskMagicNumber, 4 );
 
     const int numCommands = graphic.commands().size();
@@ -323,37 +393,20 @@ bool QskGraphicIO::write( const QskGraphic& graphic, QIODevice* dev )
 
     for ( int i = 0; i < numCommands; i++ )
     {
-        stream << static_cast< quint8 >( cmds[ i ].type() );
-
-        switch ( cmds[ i ].type() )
+        if ( !qskWriteCommand( cmds[ i ], stream ) )
         {
-            case QskPainterCommand::Path:
-            {
-                qskWritePathData( *cmds[ i ].path(), stream );
-                break;
-            }
-            case QskPainterCommand::Pixmap:
-            {
-                qskWritePixmapData( *cmds[ i ].pixmapData(), stream );
-                break;
-            }
-            case QskPainterCommand::Image:
-            {
-                qskWriteImageData( *cmds[ i ].imageData(), stream );
-                break;
-            }
-            case QskPainterCommand::State:
-            {
-                qskWriteStateData( *cmds[ i ].stateData(), stream );
-                break;
-            }
-            default:
-            {
-                // cleanup ???
-                return false;
-            }
+            // cleanup ???
+            return false;
         }
     }
 
     return true;
 }
+
+bool QskGraphicIO::writeCommand( const QskPainterCommand& command, QByteArray& data )
+{
+    QDataStream stream( &data, QIODevice::WriteOnly );
+    qskInitStream( stream );
+
+    return qskWriteCommand( command, stream );
+}
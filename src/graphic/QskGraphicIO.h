@@ -9,19 +9,42 @@
 #include "QskGlobal.h"
 
 class QskGraphic;
+class QskPainterCommand;
 class QString;
 class QIODevice;
 class QByteArray;
 
 namespace QskGraphicIO
 {
+    enum Format
+    {
+        // the portable format, where each command is a QDataStream record
+        Stream,
+
+        /*
+            The flat layout of QskGraphicMapping, that is rendered from
+            the memory of the file without decoding the paths.
+         */
+        Mapped
+    };
+
+    // reading detects the format from the magic number
     QSK_EXPORT QskGraphic read( const QString& fileName );
     QSK_EXPORT QskGraphic read( const QByteArray& data );
     QSK_EXPORT QskGraphic read( QIODevice* dev );
 
-    QSK_EXPORT bool write( const QskGraphic&, const QString& fileName );
-    QSK_EXPORT bool write( const QskGraphic&, QByteArray& data );
-    QSK_EXPORT bool write( const QskGraphic&, QIODevice* dev );
+    QSK_EXPORT bool write( const QskGraphic&,
+        const QString& fileName, Format = Stream );
+
+    QSK_EXPORT bool write( const QskGraphic&,
+        QByteArray& data, Format = Stream );
+
+    QSK_EXPORT bool write( const QskGraphic&,
+        QIODevice* dev, Format = Stream );
+
+    // a single command as QDataStream record
+    QSK_EXPORT QskPainterCommand readCommand( const QByteArray& );
+    QSK_EXPORT bool writeCommand( const QskPainterCommand&, QByteArray& );
 }
 
 #endif
@@ -0,0 +1,753 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskGraphicMapping.h"
+#include "QskGraphicIO.h"
+#include "QskPainterCommand.h"
+
+#include <qfile.h>
+#include <qmutex.h>
+#include <qpainter.h>
+#include <qpainterpath.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qpainter_p.h>
+#include <private/qpaintengineex_p.h>
+#include <private/qvectorpath_p.h>
+QSK_QT_PRIVATE_END
+
+#include <cstring>
+#include <type_traits>
+
+static const char qskMappingMagicNumber[] = "QSKM";
+static const quint16 qskMappingVersion = 1;
+
+// written in the byte order of the host, what allows to detect a mismatch
+static const quint16 qskMappingByteOrder = 0x0102;
+
+/*
+    To avoid subobject-linkage warnings, when including the source code in
+    svg2qvg we don't use an anonymous namespace here
+ */
+namespace QskGraphicPrivate
+{
+    /*
+        All tables start at offsets, that are aligned to 8 bytes, so that
+        they can be accessed in place. Rectangles are stored as
+        x, y, width, height.
+     */
+
+    class MappingHeader
+    {
+      public:
+        char magicNumber[ 4 ];
+        quint16 version;
+        quint16 byteOrder;
+
+        quint32 commandTypes;
+
+        quint32 commandCount;
+        quint32 pathCount;
+        quint32 pathInfoCount;
+        quint32 elementCount;
+        quint32 stateCount;
+
+        // offsets of the tables, relative to the beginning of the header
+        quint32 commandOffset;
+        quint32 pathOffset;
+        quint32 pathInfoOffset;
+        quint32 elementOffset;
+        quint32 pointOffset;
+        quint32 stateOffset;
+        quint32 stateDataOffset;
+
+        // the size of the header and all tables
+        quint32 size;
+
+        double boundingRect[ 4 ];
+        double pointRect[ 4 ];
+    };
+
+    class MappingCommand
+    {
+      public:
+        quint32 type;
+
+        // index in the path or in the state table
+        quint32 index;
+    };
+
+    class MappingPath
+    {
+      public:
+        enum Flag : quint16
+        {
+            CurvedShape = 1 << 0,
+
+            // nothing but alternating move/line elements
+            LinesShape = 1 << 1
+        };
+
+        // range in the element and point tables
+        quint32 firstElement;
+        quint32 elementCount;
+
+        quint16 fillRule;
+        quint16 flags;
+
+        quint32 reserved;
+    };
+
+    class MappingPathInfo
+    {
+      public:
+        double pointRect[ 4 ];
+        double boundingRect[ 4 ];
+
+        quint32 scalablePen;
+        quint32 reserved;
+    };
+
+    class MappingState
+    {
+      public:
+        // QDataStream record of the command in the state data
+        quint32 offset;
+        quint32 size;
+    };
+}
+
+static_assert( sizeof( QskGraphicPrivate::MappingHeader ) == 128,
+    "QskGraphicMapping: unexpected header size" );
+
+static_assert( sizeof( QskGraphicPrivate::MappingPath ) == 16,
+    "QskGraphicMapping: unexpected path size" );
+
+static_assert( sizeof( QskGraphicPrivate::MappingPathInfo ) == 72,
+    "QskGraphicMapping: unexpected path info size" );
+
+// the element table is passed as it is to the paint engines
+static_assert( sizeof( QPainterPath::ElementType ) == sizeof( qint32 ),
+    "QskGraphicMapping: unexpected size of QPainterPath::ElementType" );
+
+static inline quint32 qskAligned( quint32 size )
+{
+    return ( size + 7 ) & ~7u;
+}
+
+static inline bool qskIsInside( quint64 offset,
+    quint64 count, quint64 itemSize, quint64 size )
+{
+    return ( offset % 8 == 0 ) && ( offset + count * itemSize <= size );
+}
+
+static inline QRectF qskRect( const double values[ 4 ] )
+{
+    return QRectF( values[ 0 ], values[ 1 ], values[ 2 ], values[ 3 ] );
+}
+
+static inline void qskSetRect( const QRectF& rect, double values[ 4 ] )
+{
+    values[ 0 ] = rect.x();
+    values[ 1 ] = rect.y();
+    values[ 2 ] = rect.width();
+    values[ 3 ] = rect.height();
+}
+
+template< typename T >
+static inline void qskCopyTable( char* to, const QVector< T >& table )
+{
+    if ( !table.isEmpty() )
+        memcpy( to, table.constData(), table.size() * sizeof( T ) );
+}
+
+static bool qskIsValidPath( const qint32* types, quint32 count )
+{
+    /*
+        The paint engines expect the curve elements to be followed by
+        their control points. As the elements are not decoded, we have to
+        make sure, that they are consistent.
+     */
+
+    if ( count == 0 )
+        return true;
+
+    if ( types[ 0 ] != QPainterPath::MoveToElement )
+        return false;
+
+    for ( quint32 i = 1; i < count; i++ )
+    {
+        switch ( types[ i ] )
+        {
+            case QPainterPath::MoveToElement:
+            case QPainterPath::LineToElement:
+                break;
+
+            case QPainterPath::CurveToElement:
+            {
+                if ( ( i + 2 >= count )
+                    || ( types[ i + 1 ] != QPainterPath::CurveToDataElement )
+                    || ( types[ i + 2 ] != QPainterPath::CurveToDataElement ) )
+                {
+                    return false;
+                }
+
+                i += 2;
+                break;
+            }
+
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+class QskGraphicMapping::PrivateData
+{
+  public:
+    bool setup( const QByteArray& );
+
+    // the memory of a mapped file is unmapped, when the file gets destroyed
+    std::unique_ptr< QFile > file;
+
+    // a copy of unaligned data
+    QVector< quint64 > alignedData;
+
+    QByteArray data;
+
+    const QskGraphicPrivate::MappingHeader* header = nullptr;
+    const QskGraphicPrivate::MappingCommand* commands = nullptr;
+    const QskGraphicPrivate::MappingPath* paths = nullptr;
+    const QskGraphicPrivate::MappingPathInfo* pathInfos = nullptr;
+    const qint32* elementTypes = nullptr;
+    const double* points = nullptr;
+
+    // the decoded state, pixmap and image commands, indexed like the state table
+    QVector< QskPainterCommand > states;
+
+    QMutex mutex;
+    bool isMaterialized = false;
+    QVector< QskPainterCommand > materializedCommands;
+};
+
+bool QskGraphicMapping::PrivateData::setup( const QByteArray& bytes )
+{
+    using namespace QskGraphicPrivate;
+
+    if ( quintptr( bytes.constData() ) % 8 )
+    {
+        alignedData.resize( ( bytes.size() + 7 ) / 8 );
+        memcpy( alignedData.data(), bytes.constData(), bytes.size() );
+
+        data = QByteArray::fromRawData(
+            reinterpret_cast< const char* >( alignedData.constData() ), bytes.size() );
+    }
+    else
+    {
+        data = bytes;
+    }
+
+    const quint64 size = data.size();
+    const char* mem = data.constData();
+
+    if ( size < sizeof( MappingHeader ) )
+    {
+        qWarning( "QskGraphicMapping: truncated data" );
+        return false;
+    }
+
+    const auto hdr = reinterpret_cast< const MappingHeader* >( mem );
+
+    if ( memcmp( hdr->magicNumber, qskMappingMagicNumber, 4 ) != 0 )
+    {
+        qWarning( "QskGraphicMapping: bad magic number" );
+        return false;
+    }
+
+    if ( hdr->byteOrder != qskMappingByteOrder )
+    {
+        qWarning( "QskGraphicMapping: data has been written with a different byte order" );
+        return false;
+    }
+
+    if ( hdr->version != qskMappingVersion )
+    {
+        qWarning( "QskGraphicMapping: unsupported version %d", int( hdr->version ) );
+        return false;
+    }
+
+    if ( hdr->size > size
+        || !qskIsInside( hdr->commandOffset, hdr->commandCount, sizeof( MappingCommand ), hdr->size )
+        || !qskIsInside( hdr->pathOffset, hdr->pathCount, sizeof( MappingPath ), hdr->size )
+        || !qskIsInside( hdr->pathInfoOffset, hdr->pathInfoCount, sizeof( MappingPathInfo ), hdr->size )
+        || !qskIsInside( hdr->elementOffset, hdr->elementCount, sizeof( qint32 ), hdr->size )
+        || !qskIsInside( hdr->pointOffset, hdr->elementCount, 2 * sizeof( double ), hdr->size )
+        || !qskIsInside( hdr->stateOffset, hdr->stateCount, sizeof( MappingState ), hdr->size )
+        || hdr->stateDataOffset > hdr->size )
+    {
+        qWarning( "QskGraphicMapping: corrupted tables" );
+        return false;
+    }
+
+    header = hdr;
+    commands = reinterpret_cast< const MappingCommand* >( mem + hdr->commandOffset );
+    paths = reinterpret_cast< const MappingPath* >( mem + hdr->pathOffset );
+    pathInfos = reinterpret_cast< const MappingPathInfo* >( mem + hdr->pathInfoOffset );
+    elementTypes = reinterpret_cast< const qint32* >( mem + hdr->elementOffset );
+    points = reinterpret_cast< const double* >( mem + hdr->pointOffset );
+
+    for ( quint32 i = 0; i < hdr->pathCount; i++ )
+    {
+        const auto& path = paths[ i ];
+
+        if ( quint64( path.firstElement ) + path.elementCount > hdr->elementCount
+            || !qskIsValidPath( elementTypes + path.firstElement, path.elementCount ) )
+        {
+            qWarning( "QskGraphicMapping: corrupted path" );
+            return false;
+        }
+    }
+
+    const auto stateTable =
+        reinterpret_cast< const MappingState* >( mem + hdr->stateOffset );
+
+    const quint64 stateDataSize = hdr->size - hdr->stateDataOffset;
+
+    states.reserve( hdr->stateCount );
+
+    for ( quint32 i = 0; i < hdr->stateCount; i++ )
+    {
+        const auto& state = stateTable[ i ];
+
+        if ( quint64( state.offset ) + state.size > stateDataSize )
+        {
+            qWarning( "QskGraphicMapping: corrupted state" );
+            return false;
+        }
+
+        const auto record = QByteArray::fromRawData(
+            mem + hdr->stateDataOffset + state.offset, state.size );
+
+        const auto command = QskGraphicIO::readCommand( record );
+
+        if ( command.type() == QskPainterCommand::Invalid
+            || command.type() == QskPainterCommand::Path )
+        {
+            qWarning( "QskGraphicMapping: corrupted state" );
+            return false;
+        }
+
+        states += command;
+    }
+
+    for ( quint32 i = 0; i < hdr->commandCount; i++ )
+    {
+        const auto& command = commands[ i ];
+
+        const auto count = ( command.type == QskPainterCommand::Path )
+            ? hdr->pathCount : hdr->stateCount;
+
+        if ( command.index >= count )
+        {
+            qWarning( "QskGraphicMapping: corrupted command" );
+            return false;
+        }
+    }
+
+    return true;
+}
+
+QskGraphicMapping::QskGraphicMapping()
+{
+}
+
+QskGraphicMapping::~QskGraphicMapping()
+{
+}
+
+QskGraphicMapping QskGraphicMapping::map( const QString& fileName )
+{
+    std::unique_ptr< QFile > file( new QFile( fileName ) );
+
+    if ( file->open( QIODevice::ReadOnly ) == false )
+    {
+        qWarning( "QskGraphicMapping::map can't open %s", qPrintable( fileName ) );
+        return QskGraphicMapping();
+    }
+
+    const auto size = file->size();
+
+    const auto memory = file->map( 0, size );
+    if ( memory == nullptr )
+    {
+        // f.e. compressed resources
+        return fromData( file->readAll() );
+    }
+
+    // the memory stays mapped until the file gets destroyed
+    file->close();
+
+    auto data = std::make_shared< PrivateData >();
+    data->file = std::move( file );
+
+    const auto bytes = QByteArray::fromRawData(
+        reinterpret_cast< const char* >( memory ), size );
+
+    QskGraphicMapping mapping;
+
+    if ( data->setup( bytes ) )
+        mapping.m_data = data;
+
+    return mapping;
+}
+
+QskGraphicMapping QskGraphicMapping::fromData( const QByteArray& bytes )
+{
+    QskGraphicMapping mapping;
+
+    auto data = std::make_shared< PrivateData >();
+    if ( data->setup( bytes ) )
+        mapping.m_data = data;
+
+    return mapping;
+}
+
+QByteArray QskGraphicMapping::toData( const QskGraphic& graphic )
+{
+    using namespace QskGraphicPrivate;
+
+    const auto& commands = graphic.commands();
+
+    QVector< MappingCommand > commandTable;
+    commandTable.reserve( commands.size() );
+
+    QVector< MappingPath > pathTable;
+    QVector< qint32 > elementTypes;
+    QVector< double > points;
+
+    QVector< MappingState > stateTable;
+    QByteArray stateData;
+
+    for ( const auto& command : commands )
+    {
+        MappingCommand entry;
+        entry.type = static_cast< quint32 >( command.type() );
+
+        if ( command.type() == QskPainterCommand::Path )
+        {
+            const auto& path = *command.path();
+
+            MappingPath pathEntry;
+            pathEntry.firstElement = elementTypes.size();
+            pathEntry.elementCount = path.elementCount();
+            pathEntry.fillRule = static_cast< quint16 >( path.fillRule() );
+            pathEntry.flags = 0;
+            pathEntry.reserved = 0;
+
+            // the same hints, that are calculated by QPainterPath
+            bool isLines = true;
+
+            for ( int i = 0; i < path.elementCount(); i++ )
+            {
+                const auto element = path.elementAt( i );
+
+                elementTypes += element.type;
+                points += element.x;
+                points += element.y;
+
+                if ( element.type == QPainterPath::CurveToElement )
+                    pathEntry.flags |= MappingPath::CurvedShape;
+
+                isLines = isLines &&
+                    ( element.type == static_cast< QPainterPath::ElementType >( i % 2 ) );
+            }
+
+            if ( isLines )
+                pathEntry.flags |= MappingPath::LinesShape;
+
+            entry.index = pathTable.size();
+            pathTable += pathEntry;
+        }
+        else
+        {
+            QByteArray record;
+            if ( !QskGraphicIO::writeCommand( command, record ) )
+                return QByteArray();
+
+            MappingState stateEntry;
+            stateEntry.offset = stateData.size();
+            stateEntry.size = record.size();
+
+            entry.index = stateTable.size();
+            stateTable += stateEntry;
+
+            stateData += record;
+        }
+
+        commandTable += entry;
+    }
+
+    QVector< MappingPathInfo > pathInfoTable( graphic.pathInfoCount() );
+
+    for ( int i = 0; i < pathInfoTable.size(); i++ )
+    {
+        QRectF pointRect, boundingRect;
+        bool scalablePen;
+
+        graphic.pathInfo( i, pointRect, boundingRect, scalablePen );
+
+        auto& info = pathInfoTable[ i ];
+        qskSetRect( pointRect, info.pointRect );
+        qskSetRect( boundingRect, info.boundingRect );
+        info.scalablePen = scalablePen;
+        info.reserved = 0;
+    }
+
+    MappingHeader header;
+    memset( &header, 0, sizeof( header ) );
+
+    memcpy( header.magicNumber, qskMappingMagicNumber, 4 );
+    header.version = qskMappingVersion;
+    header.byteOrder = qskMappingByteOrder;
+
+    header.commandTypes = graphic.commandTypes();
+
+    header.commandCount = commandTable.size();
+    header.pathCount = pathTable.size();
+    header.pathInfoCount = pathInfoTable.size();
+    header.elementCount = elementTypes.size();
+    header.stateCount = stateTable.size();
+
+    quint32 offset = sizeof( header );
+
+    header.commandOffset = offset;
+    offset += qskAligned( header.commandCount * sizeof( MappingCommand ) );
+
+    header.pathOffset = offset;
+    offset += qskAligned( header.pathCount * sizeof( MappingPath ) );
+
+    header.pathInfoOffset = offset;
+    offset += qskAligned( header.pathInfoCount * sizeof( MappingPathInfo ) );
+
+    header.elementOffset = offset;
+    offset += qskAligned( header.elementCount * sizeof( qint32 ) );
+
+    header.pointOffset = offset;
+    offset += qskAligned( header.elementCount * 2 * sizeof( double ) );
+
+    header.stateOffset = offset;
+    offset += qskAligned( header.stateCount * sizeof( MappingState ) );
+
+    header.stateDataOffset = offset;
+    header.size = offset + stateData.size();
+
+    qskSetRect( graphic.boundingRect(), header.boundingRect );
+    qskSetRect( graphic.controlPointRect(), header.pointRect );
+
+    QByteArray data( header.size, '\0' );
+    auto mem = data.data();
+
+    memcpy( mem, &header, sizeof( header ) );
+
+    qskCopyTable( mem + header.commandOffset, commandTable );
+    qskCopyTable( mem + header.pathOffset, pathTable );
+    qskCopyTable( mem + header.pathInfoOffset, pathInfoTable );
+    qskCopyTable( mem + header.elementOffset, elementTypes );
+    qskCopyTable( mem + header.pointOffset, points );
+    qskCopyTable( mem + header.stateOffset, stateTable );
+
+    if ( !stateData.isEmpty() )
+        memcpy( mem + header.stateDataOffset, stateData.constData(), stateData.size() );
+
+    return data;
+}
+
+bool QskGraphicMapping::canRead( const QByteArray& data )
+{
+    return ( data.size() >= 4 )
+        && ( memcmp( data.constData(), qskMappingMagicNumber, 4 ) == 0 );
+}
+
+bool QskGraphicMapping::isValid() const
+{
+    return m_data != nullptr;
+}
+
+QskGraphic QskGraphicMapping::toGraphic() const
+{
+    QskGraphic graphic;
+
+    if ( isValid() )
+        graphic.setMapping( *this );
+
+    return graphic;
+}
+
+int QskGraphicMapping::commandCount() const
+{
+    return m_data ? m_data->header->commandCount : 0;
+}
+
+const QskPainterCommand* QskGraphicMapping::command( int index ) const
+{
+    const auto& command = m_data->commands[ index ];
+
+    if ( command.type == QskPainterCommand::Path )
+        return nullptr;
+
+    return m_data->states.constData() + command.index;
+}
+
+bool QskGraphicMapping::drawPath( QPainter* painter, int index ) const
+{
+    using namespace QskGraphicPrivate;
+
+    const auto& path = m_data->paths[ m_data->commands[ index ].index ];
+
+    if ( path.elementCount == 0 )
+        return true; // like QPaintEngineEx::drawPath
+
+    if ( !std::is_same< qreal, double >::value )
+        return false;
+
+    /*
+        For all engines derived from QPaintEngineEx - f.e raster or OpenGL -
+        QPainter::drawPath ends up in QPaintEngineEx::draw with the
+        QVectorPath of the QPainterPath. We do the same, but with a
+        QVectorPath, that is made of the element and point tables.
+     */
+
+    auto engine = QPainterPrivate::get( painter )->extended;
+    if ( engine == nullptr )
+        return false;
+
+    uint hints = ( path.fillRule == Qt::WindingFill )
+        ? QVectorPath::WindingFill : QVectorPath::OddEvenFill;
+
+    if ( path.flags & MappingPath::CurvedShape )
+        hints |= QVectorPath::CurvedShapeMask;
+
+    if ( path.flags & MappingPath::LinesShape )
+        hints |= QVectorPath::LinesShapeMask;
+    else
+        hints |= QVectorPath::AreaShapeMask | QVectorPath::NonConvexShapeMask;
+
+    const auto points = m_data->points + 2 * path.firstElement;
+    const auto types = m_data->elementTypes + path.firstElement;
+
+    const QVectorPath vectorPath(
+        reinterpret_cast< const qreal* >( points ), path.elementCount,
+        reinterpret_cast< const QPainterPath::ElementType* >( types ), hints );
+
+    engine->draw( vectorPath );
+
+    return true;
+}
+
+QPainterPath QskGraphicMapping::path( int index ) const
+{
+    const auto& path = m_data->paths[ m_data->commands[ index ].index ];
+
+    const auto points = m_data->points + 2 * path.firstElement;
+    const auto types = m_data->elementTypes + path.firstElement;
+
+    QPainterPath painterPath;
+    painterPath.setFillRule( static_cast< Qt::FillRule >( path.fillRule ) );
+    painterPath.reserve( path.elementCount );
+
+    for ( quint32 i = 0; i < path.elementCount; i++ )
+    {
+        const auto p = points + 2 * i;
+
+        switch ( types[ i ] )
+        {
+            case QPainterPath::MoveToElement:
+            {
+                painterPath.moveTo( p[ 0 ], p[ 1 ] );
+                break;
+            }
+            case QPainterPath::LineToElement:
+            {
+                painterPath.lineTo( p[ 0 ], p[ 1 ] );
+                break;
+            }
+            case QPainterPath::CurveToElement:
+            {
+                // validated in setup: always followed by 2 data elements
+                painterPath.cubicTo( p[ 0 ], p[ 1 ],
+                    p[ 2 ], p[ 3 ], p[ 4 ], p[ 5 ] );
+
+                i += 2;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return painterPath;
+}
+
+const QVector< QskPainterCommand >& QskGraphicMapping::commands() const
+{
+    static const QVector< QskPainterCommand > noCommands;
+
+    if ( m_data == nullptr )
+        return noCommands;
+
+    QMutexLocker locker( &m_data->mutex );
+
+    if ( !m_data->isMaterialized )
+    {
+        const int count = commandCount();
+
+        auto& commands = m_data->materializedCommands;
+        commands.reserve( count );
+
+        for ( int i = 0; i < count; i++ )
+        {
+            if ( const auto cmd = command( i ) )
+                commands += *cmd;
+            else
+                commands += QskPainterCommand( path( i ) );
+        }
+
+        m_data->isMaterialized = true;
+    }
+
+    return m_data->materializedCommands;
+}
+
+QskGraphic::CommandTypes QskGraphicMapping::commandTypes() const
+{
+    return static_cast< QskGraphic::CommandTypes >( m_data->header->commandTypes );
+}
+
+QRectF QskGraphicMapping::boundingRect() const
+{
+    return qskRect( m_data->header->boundingRect );
+}
+
+QRectF QskGraphicMapping::controlPointRect() const
+{
+    return qskRect( m_data->header->pointRect );
+}
+
+int QskGraphicMapping::pathInfoCount() const
+{
+    return m_data->header->pathInfoCount;
+}
+
+void QskGraphicMapping::pathInfo( int index, QRectF& pointRect,
+    QRectF& boundingRect, bool& scalablePen ) const
+{
+    const auto& info = m_data->pathInfos[ index ];
+
+    pointRect = qskRect( info.pointRect );
+    boundingRect = qskRect( info.boundingRect );
+    scalablePen = info.scalablePen;
+}
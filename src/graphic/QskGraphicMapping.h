@@ -0,0 +1,86 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_GRAPHIC_MAPPING_H
+#define QSK_GRAPHIC_MAPPING_H
+
+#include "QskGraphic.h"
+
+#include <qvector.h>
+#include <memory>
+
+class QskPainterCommand;
+class QByteArray;
+class QPainter;
+class QPainterPath;
+class QRectF;
+class QString;
+
+/*
+    QskGraphicMapping is a read only view on a graphic, that has been
+    stored in a flat binary layout: a versioned header followed by
+    contiguous tables for the commands, the paths and their geometry,
+    the element types and points of all paths and the state changes.
+
+    The element types and points are stored the way the paint engines
+    of Qt process them internally, so that paths are rendered directly
+    from the memory of the - usually memory mapped - file without
+    materializing any QPainterPath. Only the state changes, like pens
+    or brushes, are decoded, when loading.
+
+    The geometry, that is needed for scaling a graphic into a target
+    rectangle, is stored as well, so that there is no need to replay
+    all commands for calculating it, like QskGraphic::setCommands does.
+
+    The layout is written in the byte order of the host and files with a
+    different byte order are rejected. QskGraphicIO::Stream is the format
+    for exchanging graphics between different platforms.
+ */
+class QSK_EXPORT QskGraphicMapping
+{
+  public:
+    QskGraphicMapping();
+    ~QskGraphicMapping();
+
+    static QskGraphicMapping map( const QString& fileName );
+    static QskGraphicMapping fromData( const QByteArray& );
+
+    static QByteArray toData( const QskGraphic& );
+
+    // checking the magic number, the first 4 bytes are sufficient
+    static bool canRead( const QByteArray& );
+
+    bool isValid() const;
+    QskGraphic toGraphic() const;
+
+    int commandCount() const;
+
+    // the state, pixmap or image commands, nullptr for paths
+    const QskPainterCommand* command( int index ) const;
+
+    // rendering a path command without materializing it
+    bool drawPath( QPainter*, int index ) const;
+    QPainterPath path( int index ) const;
+
+    // all commands, paths are materialized on first request
+    const QVector< QskPainterCommand >& commands() const;
+
+  private:
+    friend class QskGraphic;
+
+    QskGraphic::CommandTypes commandTypes() const;
+
+    QRectF boundingRect() const;
+    QRectF controlPointRect() const;
+
+    int pathInfoCount() const;
+    void pathInfo( int index, QRectF& pointRect,
+        QRectF& boundingRect, bool& scalablePen ) const;
+
+    class PrivateData;
+    std::shared_ptr< PrivateData > m_data;
+};
+
+#endif
@@ -9,6 +9,7 @@
 #include "QskSizePolicy.h"
 #include "QskQuick.h"
 
+#include <qhash.h>
 #include <qvector.h>
 
 #include <vector>
@@ -341,12 +342,83 @@ class QskGridLayoutEngine::PrivateData
             elements.push_back( Element( spacing, grid ) );
         }
 
+        if ( isUnlimited( elements.back().grid() ) )
+            unlimitedCount++;
+
         grid = effectiveGrid( elements.back() );
 
         rowCount = qMax( rowCount, grid.bottom() + 1 );
         columnCount = qMax( columnCount, grid.right() + 1 );
 
-        return this->elements.count() - 1;
+        const int index = this->elements.count() - 1;
+
+        if ( cellIndexesValid )
+        {
+            if ( unlimitedCount > 0 && ( rowCount != indexedRowCount
+                || columnCount != indexedColumnCount ) )
+            {
+                // the effective grids of other elements might have grown
+                cellIndexesValid = false;
+            }
+            else
+            {
+                // the new element has the highest index
+                addCellIndexes( index );
+
+                indexedRowCount = rowCount;
+                indexedColumnCount = columnCount;
+            }
+        }
+
+        return index;
+    }
+
+    static inline bool isUnlimited( const QRect& grid )
+    {
+        return ( grid.width() <= 0 ) || ( grid.height() <= 0 );
+    }
+
+    static inline quint64 cellKey( int row, int column )
+    {
+        return ( quint64( quint32( row ) ) << 32 ) | quint32( column );
+    }
+
+    void addCellIndexes( int index ) const
+    {
+        const auto grid = effectiveGrid( elements[ index ] );
+
+        for ( int row = grid.top(); row <= grid.bottom(); row++ )
+        {
+            for ( int col = grid.left(); col <= grid.right(); col++ )
+            {
+                // overlapping elements: the first one wins
+                const auto key = cellKey( row, col );
+                if ( !cellIndexes.contains( key ) )
+                    cellIndexes.insert( key, index );
+            }
+        }
+    }
+
+    void updateCellIndexes() const
+    {
+        if ( cellIndexesValid )
+        {
+            if ( unlimitedCount == 0 || ( rowCount == indexedRowCount
+                && columnCount == indexedColumnCount ) )
+            {
+                return;
+            }
+        }
+
+        cellIndexes.clear();
+
+        for ( int i = 0; i < elements.count(); i++ )
+            addCellIndexes( i );
+
+        indexedRowCount = rowCount;
+        indexedColumnCount = columnCount;
+
+        cellIndexesValid = true;
     }
 
     QRect effectiveGrid( const Element& element ) const
@@ -376,6 +448,22 @@ class QskGridLayoutEngine::PrivateData
 
     int rowCount = 0;
     int columnCount = 0;
+
+    // number of elements with an unlimited span
+    int unlimitedCount = 0;
+
+    /*
+        The index of the first element occupying a cell. Appending
+        elements updates the cell indexes incrementally, while removing
+        and moving elements results in rebuilding them, when being
+        needed the next time. Effective grids with an unlimited span depend
+        on the dimensions of the grid, so the indexes are also rebuilt,
+        when the dimensions have changed.
+     */
+    mutable QHash< quint64, int > cellIndexes;
+    mutable int indexedRowCount = 0;
+    mutable int indexedColumnCount = 0;
+    mutable bool cellIndexesValid = true;
 };
 
 QskGridLayoutEngine::QskGridLayoutEngine()
@@ -467,12 +555,19 @@ qreal QskGridLayoutEngine::columnSizeHint( int column, Qt::SizeHint which ) cons
 int QskGridLayoutEngine::insertItem( QQuickItem* item, const QRect& grid )
 {
     invalidate();
-    return m_data->insertElement( item, QSizeF(), grid );
+
+    const auto index = m_data->insertElement( item, QSizeF(), grid );
+    updateItemIndexes( index );
+
+    return index;
 }
 
 int QskGridLayoutEngine::insertSpacer( const QSizeF& spacing, const QRect& grid )
 {
-    return m_data->insertElement( nullptr, spacing, grid );
+    const auto index = m_data->insertElement( nullptr, spacing, grid );
+    updateItemIndexes( index );
+
+    return index;
 }
 
 bool QskGridLayoutEngine::removeAt( int index )
@@ -483,9 +578,17 @@ bool QskGridLayoutEngine::removeAt( int index )
 
     const auto grid = element->minimumGrid();
 
+    if ( PrivateData::isUnlimited( element->grid() ) )
+        m_data->unlimitedCount--;
+
+    removeItemIndex( element->item() );
+
     auto& elements = m_data->elements;
     elements.erase( elements.begin() + index );
 
+    updateItemIndexes( index );
+    m_data->cellIndexesValid = false;
+
     // doing a lazy recalculation instead ??
 
     if ( grid.bottom() >= m_data->rowCount
@@ -516,23 +619,27 @@ bool QskGridLayoutEngine::clear()
     m_data->rowSettings.clear();
     m_data->columnSettings.clear();
 
+    m_data->unlimitedCount = 0;
+    m_data->cellIndexes.clear();
+    m_data->cellIndexesValid = true;
+
+    clearItemIndexes();
+
     invalidate();
     return true;
 }
 
 int QskGridLayoutEngine::indexAt( int row, int column ) const
 {
-    if ( row < m_data->rowCount && column < m_data->columnCount )
+    if ( row < 0 || row >= m_data->rowCount
+        || column < 0 || column >= m_data->columnCount )
     {
-        for ( uint i = 0; i < m_data->elements.size(); i++ )
-        {
-            const auto grid = m_data->effectiveGrid( m_data->elements[i] );
-            if ( grid.contains( column, row ) )
-                return i;
-        }
+        return -1;
     }
 
-    return -1;
+    m_data->updateCellIndexes();
+
+    return m_data->cellIndexes.value( PrivateData::cellKey( row, column ), -1 );
 }
 
 QQuickItem* QskGridLayoutEngine::itemAt( int index ) const
@@ -562,7 +669,13 @@ bool QskGridLayoutEngine::setGridAt( int index, const QRect& grid )
     {
         if ( element->grid() != grid )
         {
+            m_data->unlimitedCount +=
+                int( PrivateData::isUnlimited( grid ) )
+                - int( PrivateData::isUnlimited( element->grid() ) );
+
             element->setGrid( grid );
+            m_data->cellIndexesValid = false;
+
             invalidate();
 
             return true;
@@ -614,6 +727,8 @@ void QskGridLayoutEngine::transpose()
     qSwap( m_data->columnSettings, m_data->rowSettings );
     qSwap( m_data->columnCount, m_data->rowCount );
 
+    m_data->cellIndexesValid = false;
+
     invalidate();
 }
 
@@ -11,6 +11,15 @@
 
 #include <cmath>
 
+static inline qreal qskMaximumContribution( const QskLayoutChain::CellData& cell )
+{
+    // see QskLayoutChain::finish
+    if ( cell.stretch == 0 && !cell.canGrow )
+        return cell.metrics.preferred();
+
+    return cell.metrics.maximum();
+}
+
 QskLayoutChain::QskLayoutChain()
 {
 }
@@ -213,6 +222,48 @@ void QskLayoutChain::finish()
     m_boundingMetrics.setMaximum( maximum );
 }
 
+void QskLayoutChain::setCell( int index, const CellData& newCell )
+{
+    auto& cell = m_cells[ index ];
+
+    const auto maxMaximum = QskLayoutMetrics::unlimited;
+
+    const auto maximum = qskMaximumContribution( cell );
+    const auto newMaximum = qskMaximumContribution( newCell );
+
+    if ( ( cell.isValid != newCell.isValid )
+        || ( m_boundingMetrics.maximum() >= maxMaximum )
+        || ( maximum >= maxMaximum ) || ( newMaximum >= maxMaximum ) )
+    {
+        /*
+            The number of spacings or the contributions to
+            the maximum are affected: recalculating from scratch
+         */
+        cell = newCell;
+        finish();
+
+        return;
+    }
+
+    if ( cell.isValid )
+    {
+        // only the contributions of the cell itself are exchanged
+
+        m_boundingMetrics.setMinimum( m_boundingMetrics.minimum()
+            + newCell.metrics.minimum() - cell.metrics.minimum() );
+
+        m_boundingMetrics.setPreferred( m_boundingMetrics.preferred()
+            + newCell.metrics.preferred() - cell.metrics.preferred() );
+
+        m_boundingMetrics.setMaximum(
+            m_boundingMetrics.maximum() + newMaximum - maximum );
+
+        m_sumStretches += newCell.stretch - cell.stretch;
+    }
+
+    cell = newCell;
+}
+
 bool QskLayoutChain::setSpacing( qreal spacing )
 {
     if ( m_spacing != spacing )
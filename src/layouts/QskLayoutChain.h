@@ -64,6 +64,9 @@ class QskLayoutChain
     void shrinkCell( int index, const CellData& );
     void finish();
 
+    // replacing a cell of a finished chain
+    void setCell( int index, const CellData& );
+
     const CellData& cell( int index ) const { return m_cells[ index ]; }
 
     bool setSpacing( qreal spacing );
@@ -10,6 +10,7 @@
 #include "QskQuick.h"
 
 #include <qguiapplication.h>
+#include <qset.h>
 
 static QSizeF qskItemConstraint( const QQuickItem* item, const QSizeF& constraint )
 {
@@ -115,11 +116,42 @@ namespace
             return QRectF( rect.x() + x1, rect.y() + y1, x2 - x1, y2 - y1 );
         }
 
+        bool isModified( const QRect& grid ) const
+        {
+            if ( ( grid.bottom() >= previousRows.count() )
+                || ( grid.right() >= previousColumns.count() ) )
+            {
+                return true;
+            }
+
+            return !( isEqual( rows, previousRows, grid.top(), grid.bottom() )
+                && isEqual( columns, previousColumns, grid.left(), grid.right() ) );
+        }
+
         Qt::LayoutDirection direction;
 
         QRectF rect;
         QskLayoutChain::Segments rows;
         QskLayoutChain::Segments columns;
+
+        /*
+            When only some items have been invalidated, we can skip
+            all other items, as long as their cells did not move.
+         */
+        bool isPartial = false;
+
+        QskLayoutChain::Segments previousRows;
+        QskLayoutChain::Segments previousColumns;
+        QSet< const QQuickItem* > dirtyItems;
+
+      private:
+        static inline bool isEqual( const QskLayoutChain::Segments& segments1,
+            const QskLayoutChain::Segments& segments2, int from, int to )
+        {
+            // geometryAt uses the start of the first and the end of the last segment
+            return ( segments1[ from ].start == segments2[ from ].start )
+                && ( segments1[ to ].end() == segments2[ to ].end() );
+        }
     };
 }
 
@@ -132,6 +164,7 @@ class QskLayoutEngine2D::PrivateData
         , visualDirection( Qt::LeftToRight )
         , constraintType( -1 )
         , blockInvalidate( false )
+        , isLayoutValid( false )
     {
     }
 
@@ -161,6 +194,12 @@ class QskLayoutEngine2D::PrivateData
     QskLayoutChain::Segments rows;
     QskLayoutChain::Segments columns;
 
+    QHash< const QQuickItem*, int > itemIndexes;
+
+    // the rectangle of the last layout and the items, that have changed since then
+    QRectF layoutRect;
+    QSet< const QQuickItem* > dirtyItems;
+
     const LayoutData* layoutData = nullptr;
 
     unsigned int defaultAlignment : 8;
@@ -176,6 +215,9 @@ class QskLayoutEngine2D::PrivateData
         because of them.
      */
     bool blockInvalidate : 1;
+
+    // all items have been laid out for layoutRect
+    bool isLayoutValid : 1;
 };
 
 QskLayoutEngine2D::QskLayoutEngine2D()
@@ -194,6 +236,8 @@ bool QskLayoutEngine2D::setVisualDirection( Qt::LayoutDirection direction )
     if ( m_data->visualDirection != direction )
     {
         m_data->visualDirection = direction;
+        m_data->isLayoutValid = false;
+
         return true;
     }
 
@@ -210,6 +254,8 @@ bool QskLayoutEngine2D::setDefaultAlignment( Qt::Alignment alignment )
     if ( defaultAlignment() != alignment )
     {
         m_data->defaultAlignment = alignment;
+        m_data->isLayoutValid = false;
+
         return true;
     }
 
@@ -286,26 +332,39 @@ bool QskLayoutEngine2D::setExtraSpacingAt( Qt::Edges edges )
     m_data->rows.clear();
     m_data->columns.clear();
 
+    m_data->isLayoutValid = false;
+
     return true;
 }
 
 int QskLayoutEngine2D::indexOf( const QQuickItem* item ) const
 {
-    if ( item )
-    {
-        /*
-           indexOf is often called after inserting an item to
-           set additinal properties. So we search in reverse order
-         */
+    if ( item == nullptr )
+        return -1;
 
-        for ( int i = count() - 1; i >= 0; --i )
-        {
-            if ( itemAt( i ) == item )
-                return i;
-        }
+    return m_data->itemIndexes.value( item, -1 );
+}
+
+void QskLayoutEngine2D::updateItemIndexes( int from )
+{
+    auto& indexes = m_data->itemIndexes;
+
+    for ( int i = qMax( from, 0 ); i < count(); i++ )
+    {
+        if ( const auto item = itemAt( i ) )
+            indexes.insert( item, i );
     }
+}
+
+void QskLayoutEngine2D::removeItemIndex( const QQuickItem* item )
+{
+    if ( item )
+        m_data->itemIndexes.remove( item );
+}
 
-    return -1;
+void QskLayoutEngine2D::clearItemIndexes()
+{
+    m_data->itemIndexes.clear();
 }
 
 Qt::Edges QskLayoutEngine2D::extraSpacingAt() const
@@ -318,6 +377,22 @@ void QskLayoutEngine2D::setGeometries( const QRectF& rect )
     if ( rowCount() < 1 || columnCount() < 1 )
         return;
 
+    LayoutData data;
+
+    if ( m_data->isLayoutValid && !m_data->dirtyItems.isEmpty()
+        && ( m_data->layoutRect == rect ) )
+    {
+        // only some items have changed since the last layout
+        data.isPartial = true;
+        data.previousRows = m_data->rows;
+        data.previousColumns = m_data->columns;
+    }
+
+    data.dirtyItems.swap( m_data->dirtyItems );
+
+    m_data->layoutRect = rect;
+    m_data->isLayoutValid = true;
+
     if ( m_data->layoutSize != rect.size() )
     {
         m_data->layoutSize = rect.size();
@@ -329,7 +404,6 @@ void QskLayoutEngine2D::setGeometries( const QRectF& rect )
         geometry changes - what doesn't make much sense - we
         better make a ( implicitely shared ) copy of the rows/columns.
      */
-    LayoutData data;
     data.rows = m_data->rows;
     data.columns = m_data->columns;
     data.rect = rect;
@@ -350,6 +424,12 @@ void QskLayoutEngine2D::layoutItem( QQuickItem* item, const QRect& grid ) const
     if ( layoutData == nullptr || item == nullptr )
         return;
 
+    if ( layoutData->isPartial && !layoutData->dirtyItems.contains( item )
+        && !layoutData->isModified( grid ) )
+    {
+        return; // nothing has changed for this item
+    }
+
     auto alignment = qskLayoutAlignmentHint( item );
     alignment = m_data->effectiveAlignment( alignment );
 
@@ -601,11 +681,79 @@ void QskLayoutEngine2D::updateSegments( const QSizeF& size ) const
     m_data->blockInvalidate = false;
 }
 
+bool QskLayoutEngine2D::invalidateItem( const QQuickItem* item )
+{
+    if ( m_data->blockInvalidate )
+        return true;
+
+    const auto rowMetrics = m_data->rowChain.boundingMetrics();
+    const auto columnMetrics = m_data->columnChain.boundingMetrics();
+
+    if ( !updateChains( item ) )
+    {
+        invalidate();
+        return true;
+    }
+
+    m_data->dirtyItems.insert( item );
+
+    // the segments have to be recalculated
+    m_data->layoutSize = QSize();
+
+    return ( m_data->rowChain.boundingMetrics() != rowMetrics )
+        || ( m_data->columnChain.boundingMetrics() != columnMetrics );
+}
+
+bool QskLayoutEngine2D::updateChains( const QQuickItem* item )
+{
+    if ( item == nullptr )
+        return false;
+
+    /*
+        In constrained layouts the cells of one chain depend on the
+        segments of the other chain, so we support unconstrained layouts only
+     */
+    if ( m_data->constraintType != QskSizePolicy::Unconstrained
+        || qskSizePolicy( item ).constraintType() != QskSizePolicy::Unconstrained )
+    {
+        return false;
+    }
+
+    for ( auto orientation : { Qt::Horizontal, Qt::Vertical } )
+    {
+        const auto& chain = m_data->layoutChain( orientation );
+
+        if ( ( chain.constraint() != -1.0 )
+            || ( chain.count() != effectiveCount( orientation ) ) )
+        {
+            return false; // not set up yet
+        }
+    }
+
+    m_data->blockInvalidate = true;
+
+    const bool ok = updateChain( Qt::Horizontal, item, m_data->columnChain )
+        && updateChain( Qt::Vertical, item, m_data->rowChain );
+
+    m_data->blockInvalidate = false;
+
+    return ok;
+}
+
+bool QskLayoutEngine2D::updateChain( Qt::Orientation,
+    const QQuickItem*, QskLayoutChain& ) const
+{
+    return false;
+}
+
 void QskLayoutEngine2D::invalidate( int what )
 {
     if ( m_data->blockInvalidate )
         return;
 
+    m_data->isLayoutValid = false;
+    m_data->dirtyItems.clear();
+
     if ( what & ElementCache )
     {
         m_data->constraintType = -1;
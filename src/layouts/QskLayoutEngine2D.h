@@ -10,6 +10,7 @@
 #include "QskLayoutChain.h"
 #include "QskSizePolicy.h"
 
+#include <qhash.h>
 #include <qnamespace.h>
 #include <memory>
 
@@ -47,6 +48,14 @@ class QskLayoutEngine2D
 
     void invalidate();
 
+    /*
+        Updating the cells of an item only, after its layout relevant hints
+        have changed. When this is not possible the complete layout gets
+        invalidated. Returns false, when the size hints of the layout
+        have not been affected.
+     */
+    bool invalidateItem( const QQuickItem* );
+
     qreal widthForHeight( qreal height ) const;
     qreal heightForWidth( qreal width ) const;
 
@@ -56,6 +65,16 @@ class QskLayoutEngine2D
 
   protected:
 
+    /*
+        The engines have to keep the index of their items up to date, so
+        that indexOf is O(1). As inserting or removing an element shifts
+        the following elements anyway, updating their indexes
+        does not increase the complexity.
+     */
+    void updateItemIndexes( int from );
+    void removeItemIndex( const QQuickItem* );
+    void clearItemIndexes();
+
     void layoutItem( QQuickItem*, const QRect& grid ) const;
     QskLayoutMetrics layoutMetrics( const QQuickItem*,
         Qt::Orientation, qreal constraint ) const;
@@ -72,6 +91,7 @@ class QskLayoutEngine2D
     Q_DISABLE_COPY( QskLayoutEngine2D )
 
     void updateSegments( const QSizeF& ) const;
+    bool updateChains( const QQuickItem* );
 
     virtual void layoutItems() = 0;
     virtual int effectiveCount( Qt::Orientation ) const = 0;
@@ -85,6 +105,13 @@ class QskLayoutEngine2D
     virtual void setupChain( Qt::Orientation,
         const QskLayoutChain::Segments&, QskLayoutChain& ) const = 0;
 
+    /*
+        Updating the cells of an item in a finished, unconstrained chain.
+        Returning false leads to a complete invalidation.
+     */
+    virtual bool updateChain( Qt::Orientation,
+        const QQuickItem*, QskLayoutChain& ) const;
+
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
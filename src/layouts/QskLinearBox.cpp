@@ -18,9 +18,9 @@ static void qskSetItemActive( QObject* receiver, const QQuickItem* item, bool on
     if ( on )
     {
         auto sendLayoutRequest =
-            [receiver]()
+            [receiver, item]()
             {
-                QEvent event( QEvent::LayoutRequest );
+                QskLayoutRequestEvent event( item );
                 QCoreApplication::sendEvent( receiver, &event );
             };
 
@@ -248,7 +248,19 @@ bool QskLinearBox::event( QEvent* event )
     {
         case QEvent::LayoutRequest:
         {
-            invalidate();
+            if ( const auto item = qskLayoutRequestItem( event ) )
+            {
+                // updating the cells of the item only
+                if ( m_data->engine.invalidateItem( item ) )
+                    resetImplicitSize();
+
+                polish();
+            }
+            else
+            {
+                invalidate();
+            }
+
             break;
         }
         case QEvent::LayoutDirectionChange:
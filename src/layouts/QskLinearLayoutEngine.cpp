@@ -39,6 +39,12 @@ namespace
         QskLayoutChain::CellData cell(
             Qt::Orientation, bool isLayoutOrientation ) const;
 
+        // the metrics of the item from the last unconstrained setupChain
+        bool hasCachedMetrics( Qt::Orientation ) const;
+        QskLayoutMetrics cachedMetrics( Qt::Orientation ) const;
+        void setCachedMetrics( Qt::Orientation, const QskLayoutMetrics& );
+        void resetCachedMetrics( Qt::Orientation );
+
       private:
 
         union
@@ -47,8 +53,11 @@ namespace
             qreal m_spacing;
         };
 
+        QskLayoutMetrics m_metrics[ 2 ];
+
         int m_stretch = -1;
         bool m_isSpacer;
+        bool m_hasMetrics[ 2 ] = { false, false };
     };
 
     class ElementsVector : public std::vector< Element >
@@ -79,6 +88,12 @@ Element::Element( const Element& other )
         m_spacing = other.m_spacing;
     else
         m_item = other.m_item;
+
+    for ( int i = 0; i < 2; i++ )
+    {
+        m_metrics[ i ] = other.m_metrics[ i ];
+        m_hasMetrics[ i ] = other.m_hasMetrics[ i ];
+    }
 }
 
 Element& Element::operator=( const Element& other )
@@ -92,6 +107,12 @@ Element& Element::operator=( const Element& other )
 
     m_stretch = other.m_stretch;
 
+    for ( int i = 0; i < 2; i++ )
+    {
+        m_metrics[ i ] = other.m_metrics[ i ];
+        m_hasMetrics[ i ] = other.m_hasMetrics[ i ];
+    }
+
     return *this;
 }
 
@@ -115,6 +136,30 @@ inline void Element::setStretch( int stretch )
     m_stretch = stretch;
 }
 
+inline bool Element::hasCachedMetrics( Qt::Orientation orientation ) const
+{
+    return m_hasMetrics[ orientation == Qt::Horizontal ? 0 : 1 ];
+}
+
+inline QskLayoutMetrics Element::cachedMetrics( Qt::Orientation orientation ) const
+{
+    return m_metrics[ orientation == Qt::Horizontal ? 0 : 1 ];
+}
+
+inline void Element::setCachedMetrics(
+    Qt::Orientation orientation, const QskLayoutMetrics& metrics )
+{
+    const int index = ( orientation == Qt::Horizontal ) ? 0 : 1;
+
+    m_metrics[ index ] = metrics;
+    m_hasMetrics[ index ] = true;
+}
+
+inline void Element::resetCachedMetrics( Qt::Orientation orientation )
+{
+    m_hasMetrics[ orientation == Qt::Horizontal ? 0 : 1 ] = false;
+}
+
 bool Element::isIgnored() const
 {
     return !( m_isSpacer || qskIsVisibleToLayout( m_item ) );
@@ -280,6 +325,8 @@ int QskLinearLayoutEngine::insertItem( QQuickItem* item, int index )
         elements.emplace( elements.begin() + index, item );
     }
 
+    updateItemIndexes( index );
+
     invalidate();
     return index;
 }
@@ -300,6 +347,8 @@ int QskLinearLayoutEngine::insertSpacerAt( int index, qreal spacing )
         elements.emplace( elements.begin() + index, spacing );
     }
 
+    updateItemIndexes( index );
+
     invalidate( LayoutCache );
     return index;
 }
@@ -320,7 +369,11 @@ bool QskLinearLayoutEngine::removeAt( int index )
     if ( itemType > QskSizePolicy::Unconstrained )
         invalidationMode |= ElementCache;
 
+    removeItemIndex( element->item() );
+
     m_data->elements.erase( m_data->elements.begin() + index );
+    updateItemIndexes( index );
+
     invalidate( invalidationMode );
 
     return true;
@@ -332,6 +385,8 @@ bool QskLinearLayoutEngine::clear()
         return false;
 
     m_data->elements.clear();
+    clearItemIndexes();
+
     invalidate();
 
     return true;
@@ -440,10 +495,13 @@ void QskLinearLayoutEngine::setupChain( Qt::Orientation orientation,
 
     qreal constraint = -1.0;
 
-    for ( const auto& element : m_data->elements )
+    for ( auto& element : m_data->elements )
     {
         if ( element.isIgnored() )
+        {
+            element.resetCachedMetrics( orientation );
             continue;
+        }
 
         if ( !constraints.isEmpty() )
             constraint = constraints[index1].length;
@@ -451,8 +509,16 @@ void QskLinearLayoutEngine::setupChain( Qt::Orientation orientation,
         auto cell = element.cell( orientation, isLayoutOrientation );
 
         if ( element.item() )
+        {
             cell.metrics = layoutMetrics( element.item(), orientation, constraint );
 
+            // remembering the metrics for updateChain
+            if ( constraints.isEmpty() )
+                element.setCachedMetrics( orientation, cell.metrics );
+            else
+                element.resetCachedMetrics( orientation );
+        }
+
         chain.expandCell( index2, cell );
 
         if ( isLayoutOrientation )
@@ -473,3 +539,89 @@ void QskLinearLayoutEngine::setupChain( Qt::Orientation orientation,
         }
     }
 }
+
+bool QskLinearLayoutEngine::updateChain( Qt::Orientation orientation,
+    const QQuickItem* item, QskLayoutChain& chain ) const
+{
+    const int index = indexOf( item );
+
+    auto element = m_data->elementAt( index );
+    if ( element == nullptr || element->isIgnored()
+        || !element->hasCachedMetrics( orientation ) )
+    {
+        return false;
+    }
+
+    element->setCachedMetrics( orientation,
+        layoutMetrics( item, orientation, -1.0 ) );
+
+    // the position of the element, when ignoring the hidden ones
+
+    uint pos = index;
+
+    if ( effectiveCount() != count() )
+    {
+        pos = 0;
+        for ( int i = 0; i < index; i++ )
+        {
+            if ( !m_data->elements[i].isIgnored() )
+                pos++;
+        }
+    }
+
+    const bool isLayoutOrientation = ( orientation == m_data->orientation );
+    const auto dimension = m_data->dimension;
+
+    const uint cellIndex = isLayoutOrientation
+        ? ( pos % dimension ) : ( pos / dimension );
+
+    if ( isLayoutOrientation && uint( effectiveCount() ) <= dimension )
+    {
+        // a single row/column: the element is the only one in its cell
+
+        auto cell = element->cell( orientation, isLayoutOrientation );
+        cell.metrics = element->cachedMetrics( orientation );
+
+        chain.setCell( cellIndex, cell );
+        return true;
+    }
+
+    /*
+        Several elements share the same cell. Instead of calling
+        layoutMetrics for all of them again we merge their cached metrics.
+     */
+    QskLayoutChain cellChain;
+    cellChain.reset( 1, -1.0 );
+
+    pos = 0;
+
+    for ( const auto& e : m_data->elements )
+    {
+        if ( e.isIgnored() )
+            continue;
+
+        const uint idx = isLayoutOrientation
+            ? ( pos % dimension ) : ( pos / dimension );
+
+        pos++;
+
+        if ( idx != cellIndex )
+            continue;
+
+        auto cell = e.cell( orientation, isLayoutOrientation );
+
+        if ( e.item() )
+        {
+            if ( !e.hasCachedMetrics( orientation ) )
+                return false;
+
+            cell.metrics = e.cachedMetrics( orientation );
+        }
+
+        cellChain.expandCell( 0, cell );
+    }
+
+    chain.setCell( cellIndex, cellChain.cell( 0 ) );
+
+    return true;
+}
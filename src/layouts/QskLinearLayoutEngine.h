@@ -58,6 +58,9 @@ class QskLinearLayoutEngine : public QskLayoutEngine2D
     virtual void setupChain( Qt::Orientation,
         const QskLayoutChain::Segments&, QskLayoutChain& ) const override;
 
+    bool updateChain( Qt::Orientation,
+        const QQuickItem*, QskLayoutChain& ) const override;
+
     class PrivateData;
     std::unique_ptr< PrivateData > m_data;
 };
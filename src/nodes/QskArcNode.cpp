@@ -6,20 +6,48 @@
 #include "QskArcNode.h"
 #include "QskArcMetrics.h"
 #include "QskArcRenderer.h"
+#include "QskFrameStatistics.h"
 #include "QskGradient.h"
 
-namespace
+#include <qglobalstatic.h>
+#include <qsgvertexcolormaterial.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qsgnode_p.h>
+QSK_QT_PRIVATE_END
+
+Q_GLOBAL_STATIC( QSGVertexColorMaterial, qskMaterialVertex )
+
+static inline QskHashValue qskArcHash(
+    const QskArcMetrics& metrics, const QskGradient& gradient )
 {
-    class ArcData
-    {
-      public:
-        const QskArcMetrics& metrics;
-        const QskGradient& gradient;
-    };
+    QskHashValue hash = 14000;
+
+    hash = metrics.hash( hash );
+    return gradient.hash( hash );
 }
 
+class QskArcNodePrivate final : public QSGGeometryNodePrivate
+{
+  public:
+    QskArcNodePrivate()
+        : geometry( QSGGeometry::defaultAttributes_ColoredPoint2D(), 0 )
+    {
+    }
+
+    QskHashValue hash = 0;
+    QRectF rect;
+
+    QSGGeometry geometry;
+};
+
 QskArcNode::QskArcNode()
+    : QSGGeometryNode( *new QskArcNodePrivate )
 {
+    Q_D( QskArcNode );
+
+    setMaterial( qskMaterialVertex );
+    setGeometry( &d->geometry );
 }
 
 QskArcNode::~QskArcNode()
@@ -27,31 +55,29 @@ QskArcNode::~QskArcNode()
 }
 
 void QskArcNode::setArcData( const QRectF& rect, const QskArcMetrics& metrics,
-    const QskGradient& gradient, QQuickWindow* window )
+    const QskGradient& gradient, QQuickWindow* )
 {
-    const ArcData arcData { metrics, gradient };
-    update( window, rect, QSizeF(), &arcData );
-}
+    Q_D( QskArcNode );
 
-void QskArcNode::paint( QPainter* painter, const QSize& size, const void* nodeData )
-{
-    const auto arcData = reinterpret_cast< const ArcData* >( nodeData );
+    /*
+        The arc is tessellated, so that changing its angles - f.e. when
+        animating the value of a progress bar - results in updating
+        a vertex buffer only.
+     */
 
-    const qreal w = arcData->metrics.width();
-    const QRectF rect( 0.5 * w, 0.5 * w, size.width() - w, size.height() - w );
+    const auto hash = qskArcHash( metrics, gradient );
 
-    QskArcRenderer renderer;
-    renderer.renderArc( rect, arcData->metrics, arcData->gradient, painter );
-}
+    if ( ( hash == d->hash ) && ( rect == d->rect ) )
+        return;
 
-QskHashValue QskArcNode::hash( const void* nodeData ) const
-{
-    const auto arcData = reinterpret_cast< const ArcData* >( nodeData );
+    d->hash = hash;
+    d->rect = rect;
 
-    auto h = arcData->metrics.hash();
+    QskArcRenderer renderer;
+    renderer.renderArc( rect, metrics, gradient, d->geometry );
 
-    for( const auto& stop : qAsConst( arcData->gradient.stops() ) )
-        h = stop.hash( h );
+    markDirty( QSGNode::DirtyGeometry );
 
-    return h;
+    QskFrameStatistics::count( QskFrameStatistics::GeometryBytes,
+        d->geometry.vertexCount() * d->geometry.sizeOfVertex() );
 }
@@ -6,14 +6,17 @@
 #ifndef QSK_ARC_NODE_H
 #define QSK_ARC_NODE_H
 
-#include "QskPaintedNode.h"
+#include "QskGlobal.h"
+#include <qsgnode.h>
 
 class QskArcMetrics;
 class QskGradient;
 
-// should be a QSGGeometryNode, TODO ..
+class QQuickWindow;
 
-class QSK_EXPORT QskArcNode : public QskPaintedNode
+class QskArcNodePrivate;
+
+class QSK_EXPORT QskArcNode : public QSGGeometryNode
 {
   public:
     QskArcNode();
@@ -22,9 +25,8 @@ class QSK_EXPORT QskArcNode : public QskPaintedNode
     void setArcData( const QRectF&, const QskArcMetrics&,
         const QskGradient&, QQuickWindow* );
 
-  protected:
-    void paint( QPainter*, const QSize&, const void* nodeData ) override;
-    QskHashValue hash( const void* nodeData ) const override;
+  private:
+    Q_DECLARE_PRIVATE( QskArcNode )
 };
 
 #endif
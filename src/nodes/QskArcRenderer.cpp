@@ -6,9 +6,223 @@
 #include "QskArcRenderer.h"
 #include "QskArcMetrics.h"
 #include "QskGradient.h"
+#include "QskBoxRendererColorMap.h"
+#include "QskVertex.h"
 
+#include <qmath.h>
 #include <qpainter.h>
 #include <qrect.h>
+#include <qsggeometry.h>
+
+using namespace QskVertex;
+
+namespace
+{
+    class ArcGeometry
+    {
+      public:
+        ArcGeometry( const QRectF& rect, const QskArcMetrics& metrics )
+            : cx( rect.center().x() )
+            , cy( rect.center().y() )
+            , rx( 0.5 * rect.width() )
+            , ry( 0.5 * rect.height() )
+            , radians1( qDegreesToRadians( metrics.startAngle() ) )
+            , radians2( qDegreesToRadians( metrics.endAngle() ) )
+        {
+            const qreal w = qMax( metrics.width(), 0.0 );
+
+            innerRx = qMax( rx - w, 0.0 );
+            innerRy = qMax( ry - w, 0.0 );
+
+            // tessellating the outer border in steps of 3 pixels
+            const qreal length = qAbs( radians2 - radians1 ) * qMax( rx, ry );
+            stepCount = qBound( 3, qCeil( length / 3.0 ), 360 );
+        }
+
+        /*
+            t is the relative position between the inner ( 0.0 )
+            and the outer ( 1.0 ) border.
+         */
+        inline qreal x( qreal cos, qreal t ) const
+        {
+            return cx + ( innerRx + t * ( rx - innerRx ) ) * cos;
+        }
+
+        inline qreal y( qreal sin, qreal t ) const
+        {
+            // angles are counterclockwise, while y is pointing down
+            return cy - ( innerRy + t * ( ry - innerRy ) ) * sin;
+        }
+
+        inline void setLine( qreal cos, qreal sin, qreal t1, qreal t2,
+            Color c1, Color c2, ColoredLine* line ) const
+        {
+            line->setLine( x( cos, t1 ), y( sin, t1 ), c1,
+                x( cos, t2 ), y( sin, t2 ), c2 );
+        }
+
+        qreal cx, cy;
+        qreal rx, ry;
+        qreal innerRx, innerRy;
+
+        qreal radians1, radians2;
+        int stepCount;
+    };
+
+    class AngleIterator
+    {
+      public:
+        AngleIterator( qreal radians1, qreal radians2, int stepCount )
+            : m_radians2( radians2 )
+            , m_stepIndex( 0 )
+            , m_stepCount( stepCount )
+        {
+            m_cos = qCos( radians1 );
+            m_sin = qSin( radians1 );
+
+            const qreal stepAngle = ( radians2 - radians1 ) / stepCount;
+            m_cosStep = qCos( stepAngle );
+            m_sinStep = qSin( stepAngle );
+        }
+
+        inline qreal cos() const { return m_cos; }
+        inline qreal sin() const { return m_sin; }
+
+        inline qreal value() const { return qreal( m_stepIndex ) / m_stepCount; }
+
+        inline bool advance()
+        {
+            if ( ++m_stepIndex == m_stepCount )
+            {
+                // avoiding rounding errors at the end of the arc
+                m_cos = qCos( m_radians2 );
+                m_sin = qSin( m_radians2 );
+            }
+            else
+            {
+                const qreal cos0 = m_cos;
+
+                m_cos = m_cos * m_cosStep - m_sin * m_sinStep;
+                m_sin = m_sin * m_cosStep + cos0 * m_sinStep;
+            }
+
+            return m_stepIndex <= m_stepCount;
+        }
+
+      private:
+        const qreal m_radians2;
+
+        qreal m_cos, m_sin;
+        qreal m_cosStep, m_sinStep;
+
+        int m_stepIndex;
+        const int m_stepCount;
+    };
+
+    // for gradients in direction of the arc
+    class ContourIterator
+    {
+      public:
+        ContourIterator( const ArcGeometry& arc )
+            : m_arc( arc )
+            , m_angleIt( arc.radians1, arc.radians2, arc.stepCount )
+        {
+        }
+
+        inline qreal value() const { return m_angleIt.value(); }
+        inline bool advance() { return m_angleIt.advance(); }
+
+        template< class ColorIterator >
+        inline void setGradientLine( const ColorIterator& colorIt, ColoredLine* line )
+        {
+            const qreal radians = m_arc.radians1
+                + colorIt.value() * ( m_arc.radians2 - m_arc.radians1 );
+
+            const auto color = colorIt.color();
+            m_arc.setLine( qCos( radians ), qSin( radians ),
+                0.0, 1.0, color, color, line );
+        }
+
+        template< class ColorIterator >
+        inline void setContourLine( const ColorIterator& colorIt, ColoredLine* line )
+        {
+            const auto color = colorIt.colorAt( value() );
+            m_arc.setLine( m_angleIt.cos(), m_angleIt.sin(),
+                0.0, 1.0, color, color, line );
+        }
+
+      private:
+        const ArcGeometry& m_arc;
+        AngleIterator m_angleIt;
+    };
+}
+
+static ColoredLine* qskRenderRing( const ArcGeometry& arc, bool reverse,
+    qreal t1, qreal t2, Color c1, Color c2, ColoredLine* line )
+{
+    /*
+        The rings are connected by running every other one backwards.
+        Then the triangles in between are degenerated as all their
+        points are on the same radial line.
+     */
+    const qreal radians1 = reverse ? arc.radians2 : arc.radians1;
+    const qreal radians2 = reverse ? arc.radians1 : arc.radians2;
+
+    AngleIterator it( radians1, radians2, arc.stepCount );
+
+    do
+    {
+        arc.setLine( it.cos(), it.sin(), t1, t2, c1, c2, line++ );
+    } while ( it.advance() );
+
+    return line;
+}
+
+static QskGradient qskEffectiveGradient( const ArcGeometry& arc,
+    const QskArcMetrics& metrics, const QskGradient& gradient )
+{
+    /*
+        The gradient stops are mapped like it is done by the
+        QRadialGradient/QConicalGradient of the painter based
+        implementation, so that arcs look the same as before:
+
+        - vertical: the radial gradient has its center in the center
+          of the arc and a radius of the diameter of the pen line,
+          so only a part of it is covered by the band of the arc.
+
+        - horizontal: the conical gradient starts at the start angle
+          and runs counterclockwise for 360°, so that arcs, that are
+          shorter, show only a part of it.
+
+        As the tessellation maps the stops to the band of the arc,
+        we extract the part of the gradient, that is visible.
+     */
+
+    if ( gradient.isMonochrome() )
+        return gradient;
+
+    if ( gradient.orientation() == QskGradient::Vertical )
+    {
+        const qreal radius = qMin( arc.rx, arc.ry );
+        const qreal innerRadius = qMin( arc.innerRx, arc.innerRy );
+
+        // the pen line was running in the middle of the band
+        const qreal diameter = radius + innerRadius;
+
+        if ( diameter <= 0.0 )
+            return gradient;
+
+        return gradient.extracted( innerRadius / diameter, radius / diameter );
+    }
+
+    const qreal span = qBound( -360.0, metrics.spanAngle(), 360.0 ) / 360.0;
+
+    if ( span >= 0.0 )
+        return gradient.extracted( 0.0, span );
+
+    // clockwise: starting at the end of the conical gradient
+    return gradient.extracted( 1.0 + span, 1.0 ).reversed();
+}
 
 void QskArcRenderer::renderArc(const QRectF& rect,
     const QskArcMetrics& metrics, const QskGradient& gradient,
@@ -51,3 +265,68 @@ void QskArcRenderer::renderArc(const QRectF& rect,
 
     painter->drawArc( rect, startAngle, spanAngle );
 }
+
+void QskArcRenderer::renderArc( const QRectF& rect,
+    const QskArcMetrics& metrics, const QskGradient& gradient,
+    QSGGeometry& geometry )
+{
+    if ( rect.isEmpty() || metrics.isNull() || !gradient.isValid() )
+    {
+        allocateLines< ColoredLine >( geometry, 0 );
+        return;
+    }
+
+    const ArcGeometry arc( rect, metrics );
+    const int contourLineCount = arc.stepCount + 1;
+
+    const auto effectiveGradient = qskEffectiveGradient( arc, metrics, gradient );
+    const auto& stops = effectiveGradient.stops();
+
+    if ( effectiveGradient.isMonochrome() )
+    {
+        const Color color( stops.first().color() );
+
+        auto line = allocateLines< ColoredLine >( geometry, contourLineCount );
+        qskRenderRing( arc, false, 0.0, 1.0, color, color, line );
+
+        return;
+    }
+
+    if ( effectiveGradient.orientation() == QskGradient::Vertical )
+    {
+        // from the inner to the outer border: one ring for each pair of stops
+
+        auto line = allocateLines< ColoredLine >(
+            geometry, ( stops.count() - 1 ) * contourLineCount );
+
+        for ( int i = 0; i < stops.count() - 1; i++ )
+        {
+            const auto& s1 = stops[ i ];
+            const auto& s2 = stops[ i + 1 ];
+
+            line = qskRenderRing( arc, i % 2, s1.position(), s2.position(),
+                s1.color(), s2.color(), line );
+        }
+
+        return;
+    }
+
+    /*
+        Horizontal/Diagonal are interpreted as being in direction of
+        the arc. Each stop adds a line at its angle.
+     */
+
+    const int lineCount = contourLineCount + qMax( stops.count() - 2, 0 );
+
+    const auto lines = allocateLines< ColoredLine >( geometry, lineCount );
+
+    ContourIterator contourIt( arc );
+    auto line = fillOrdered( contourIt, 0.0, 1.0, effectiveGradient, lines );
+
+    // stops, that are located at the end of the arc, did not produce a line
+    while ( line < lines + lineCount )
+    {
+        *line = *( line - 1 );
+        line++;
+    }
+}
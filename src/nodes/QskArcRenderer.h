@@ -13,12 +13,21 @@ class QskGradient;
 
 class QPainter;
 class QRectF;
+class QSGGeometry;
 
 class QSK_EXPORT QskArcRenderer
 {
   public:
     void renderArc( const QRectF&, const QskArcMetrics&,
         const QskGradient&, QPainter* );
+
+    /*
+        Tessellates the arc into a triangle strip of colored points.
+        In opposite to the painter based implementation the rectangle
+        is the outer border of the arc and not its center line.
+     */
+    void renderArc( const QRectF&, const QskArcMetrics&,
+        const QskGradient&, QSGGeometry& );
 };
 
 #endif
@@ -8,7 +8,9 @@
 #include "QskBoxBorderMetrics.h"
 #include "QskBoxRenderer.h"
 #include "QskBoxShapeMetrics.h"
+#include "QskFrameStatistics.h"
 #include "QskGradient.h"
+#include "QskVertex.h"
 
 #include <qglobalstatic.h>
 #include <qsgflatcolormaterial.h>
@@ -37,6 +39,68 @@ static inline QskHashValue qskColorsHash(
     return fillGradient.hash( hash );
 }
 
+static inline QskHashValue qskColorLayoutHash(
+    const QskBoxBorderColors& borderColors, const QskGradient& fillGradient )
+{
+    /*
+        The properties of the colors, that have an effect on
+        the number and the positions of the vertices
+     */
+    const int flags = ( fillGradient.isValid() ? 1 : 0 )
+        | ( fillGradient.isVisible() ? 2 : 0 )
+        | ( fillGradient.isMonochrome() ? 4 : 0 )
+        | ( borderColors.isVisible() ? 8 : 0 )
+        | ( borderColors.isMonochrome() ? 16 : 0 );
+
+    QskHashValue hash = qHash( flags, 13000 );
+    hash = qHash( fillGradient.orientation(), hash );
+    hash = qHash( fillGradient.stops().count(), hash );
+
+    for ( const auto edge : { Qt::LeftEdge, Qt::TopEdge, Qt::RightEdge, Qt::BottomEdge } )
+        hash = qHash( borderColors.gradientAt( edge ).stops().count(), hash );
+
+    return hash;
+}
+
+static inline bool qskIsRecolorable(
+    const QskBoxBorderColors& borderColors, const QskGradient& fillGradient )
+{
+    return fillGradient.isMonochrome() && borderColors.isMonochrome();
+}
+
+static int qskFillVertexCount( const QSGGeometry& geometry, QskVertex::Color fillColor )
+{
+    /*
+        The renderer creates the vertices for the fill first
+        and those for the border afterwards.
+     */
+    const auto points = geometry.vertexDataAsColoredPoint2D();
+
+    for ( int i = 0; i < geometry.vertexCount(); i++ )
+    {
+        const auto& p = points[ i ];
+
+        if ( QskVertex::Color( p.r, p.g, p.b, p.a ) != fillColor )
+            return i;
+    }
+
+    return geometry.vertexCount();
+}
+
+static inline void qskSetVertexColor(
+    QSGGeometry::ColoredPoint2D* points, int count, QskVertex::Color color )
+{
+    for ( int i = 0; i < count; i++ )
+    {
+        auto& p = points[ i ];
+
+        p.r = color.r;
+        p.g = color.g;
+        p.b = color.b;
+        p.a = color.a;
+    }
+}
+
 class QskBoxNodePrivate final : public QSGGeometryNodePrivate
 {
   public:
@@ -47,8 +111,15 @@ class QskBoxNodePrivate final : public QSGGeometryNodePrivate
 
     QskHashValue metricsHash = 0;
     QskHashValue colorsHash = 0;
+    QskHashValue colorLayoutHash = 0;
     QRectF rect;
 
+    /*
+        Number of vertices at the beginning of the geometry, that
+        belong to the fill. -1, when not being known
+     */
+    int fillVertexCount = -1;
+
     QSGGeometry geometry;
 };
 
@@ -98,9 +169,27 @@ void QskBoxNode::setBoxData( const QRectF& rect,
         return;
     }
 
+    const auto colorLayoutHash = qskColorLayoutHash( borderColors, fillGradient );
+
+    if ( ( metricsHash == d->metricsHash ) && ( rect == d->rect )
+        && ( colorLayoutHash == d->colorLayoutHash ) )
+    {
+        /*
+            Only the colors have changed - f.e. during a hover animation.
+            Then we can update the colors of the existing vertices.
+         */
+        if ( updateColors( borderColors, fillGradient ) )
+        {
+            d->colorsHash = colorsHash;
+            return;
+        }
+    }
+
     d->metricsHash = metricsHash;
     d->colorsHash = colorsHash;
+    d->colorLayoutHash = colorLayoutHash;
     d->rect = rect;
+    d->fillVertexCount = -1;
 
     markDirty( QSGNode::DirtyMaterial );
     markDirty( QSGNode::DirtyGeometry );
@@ -177,6 +266,16 @@ void QskBoxNode::setBoxData( const QRectF& rect,
 
         renderer.renderBox( d->rect, shape, borderMetrics,
             borderColors, fillGradient, *geometry() );
+
+        if ( qskIsRecolorable( borderColors, fillGradient ) )
+        {
+            const QskVertex::Color fillColor( fillGradient.startColor() );
+            const QskVertex::Color borderColor( borderColors.left().startColor() );
+
+            // with identical colors we can't find the border
+            if ( fillColor != borderColor )
+                d->fillVertexCount = qskFillVertexCount( d->geometry, fillColor );
+        }
     }
     else
     {
@@ -196,6 +295,45 @@ void QskBoxNode::setBoxData( const QRectF& rect,
             renderer.renderBorder( d->rect, shape, borderMetrics, *geometry() );
         }
     }
+
+    QskFrameStatistics::count( QskFrameStatistics::GeometryBytes,
+        d->geometry.vertexCount() * d->geometry.sizeOfVertex() );
+}
+
+bool QskBoxNode::updateColors(
+    const QskBoxBorderColors& borderColors, const QskGradient& fillGradient )
+{
+    Q_D( QskBoxNode );
+
+    if ( material() != qskMaterialVertex )
+        return false;
+
+    if ( !qskIsRecolorable( borderColors, fillGradient ) )
+        return false;
+
+    const QskVertex::Color fillColor( fillGradient.startColor() );
+    const QskVertex::Color borderColor( borderColors.left().startColor() );
+
+    const int vertexCount = d->geometry.vertexCount();
+
+    int fillCount = d->fillVertexCount;
+
+    if ( fillColor == borderColor )
+        fillCount = vertexCount;
+    else if ( fillCount < 0 || fillCount > vertexCount )
+        return false;
+
+    auto points = d->geometry.vertexDataAsColoredPoint2D();
+
+    qskSetVertexColor( points, fillCount, fillColor );
+    qskSetVertexColor( points + fillCount, vertexCount - fillCount, borderColor );
+
+    markDirty( QSGNode::DirtyGeometry );
+
+    QskFrameStatistics::count( QskFrameStatistics::GeometryBytes,
+        vertexCount * d->geometry.sizeOfVertex() );
+
+    return true;
 }
 
 void QskBoxNode::setMonochrome( bool on )
@@ -30,6 +30,7 @@ class QSK_EXPORT QskBoxNode : public QSGGeometryNode
 
   private:
     void setMonochrome( bool on );
+    bool updateColors( const QskBoxBorderColors&, const QskGradient& );
 
     Q_DECLARE_PRIVATE( QskBoxNode )
 
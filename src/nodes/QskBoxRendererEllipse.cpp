@@ -14,6 +14,30 @@
 #include <qmath.h>
 #include <qsggeometry.h>
 
+#if !defined( QT_COORD_TYPE )
+
+// qreal is a double
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+    #include <emmintrin.h>
+    #define QSK_CORNER_VALUES_SSE2
+#elif defined( __ARM_NEON ) && defined( __aarch64__ )
+    #include <arm_neon.h>
+    #define QSK_CORNER_VALUES_NEON
+#endif
+
+#endif
+
+#if defined( QSK_CORNER_VALUES_SSE2 ) || defined( QSK_CORNER_VALUES_NEON )
+
+/*
+    QSK_NO_SIMD forces the scalar implementation, what is
+    useful for comparing, see playground/boxbenchmark
+ */
+static const bool qskUseSimd = !qEnvironmentVariableIsSet( "QSK_NO_SIMD" );
+
+#endif
+
 using namespace QskVertex;
 
 namespace
@@ -26,6 +50,18 @@ namespace
         BottomRight = Qt::BottomRightCorner
     };
 
+    // the direction from the center of a corner towards its points
+
+    inline constexpr qreal qskSignX( int corner )
+    {
+        return ( corner == TopLeft || corner == BottomLeft ) ? -1.0 : 1.0;
+    }
+
+    inline constexpr qreal qskSignY( int corner )
+    {
+        return ( corner == TopLeft || corner == TopRight ) ? -1.0 : 1.0;
+    }
+
     class ArcIterator
     {
       public:
@@ -125,179 +161,165 @@ namespace
     {
       public:
         inline BorderValuesUniform( const QskBoxRenderer::Metrics& metrics )
-            : m_corner( metrics.corner[ 0 ] )
-            , m_dx1( m_corner.radiusInnerX )
-            , m_dy1( m_corner.radiusInnerY )
+            : m_corners( metrics.corner )
+            , m_dx1( metrics.corner[ 0 ].radiusInnerX )
+            , m_dy1( metrics.corner[ 0 ].radiusInnerY )
         {
         }
 
         inline void setAngle( qreal cos, qreal sin )
         {
-            if ( !m_corner.isCropped )
+            const auto& c = m_corners[ 0 ];
+
+            if ( !c.isCropped )
             {
-                m_dx1 = cos * m_corner.radiusInnerX;
-                m_dy1 = sin * m_corner.radiusInnerY;
+                m_dx1 = cos * c.radiusInnerX;
+                m_dy1 = sin * c.radiusInnerY;
             }
 
-            m_dx2 = cos * m_corner.radiusX;
-            m_dy2 = sin * m_corner.radiusY;
+            m_dx2 = cos * c.radiusX;
+            m_dy2 = sin * c.radiusY;
         }
 
-        inline qreal dx1( int ) const { return m_dx1; }
-        inline qreal dy1( int ) const { return m_dy1; }
-        inline qreal dx2( int ) const { return m_dx2; }
-        inline qreal dy2( int ) const { return m_dy2; }
+        inline qreal x1( int pos ) const
+            { return m_corners[ pos ].centerX + qskSignX( pos ) * m_dx1; }
+
+        inline qreal y1( int pos ) const
+            { return m_corners[ pos ].centerY + qskSignY( pos ) * m_dy1; }
+
+        inline qreal x2( int pos ) const
+            { return m_corners[ pos ].centerX + qskSignX( pos ) * m_dx2; }
+
+        inline qreal y2( int pos ) const
+            { return m_corners[ pos ].centerY + qskSignY( pos ) * m_dy2; }
 
       private:
-        const QskBoxRenderer::Metrics::Corner& m_corner;
+        const QskBoxRenderer::Metrics::Corner* m_corners;
         qreal m_dx1, m_dy1, m_dx2, m_dy2;
     };
 
-    class BorderValues
+    /*
+        The coordinates of the points of all 4 corners for a given angle
+        are calculated in parallel: value[i] = base[i] + factor * scale[i].
+        The center and the direction of the corners are already included
+        in base and scale, so that the values can be used for the border
+        and fill lines without any further calculation.
+     */
+    class CornerValues
     {
       public:
-        inline BorderValues( const QskBoxRenderer::Metrics& metrics )
-            : m_uniform( metrics.isRadiusRegular )
+        inline void setCorner( int i, qreal center, qreal sign, qreal x0, qreal r )
         {
-            for ( int i = 0; i < 4; i++ )
-            {
-                const auto& c = metrics.corner[ i ];
-                auto& v = m_inner[ i ];
-
-                if ( c.radiusInnerX >= 0.0 )
-                {
-                    v.x0 = 0.0;
-                    v.rx = c.radiusInnerX;
-                }
-                else
-                {
-                    v.x0 = c.radiusInnerX;
-                    v.rx = 0.0;
-                }
-
-                if ( c.radiusInnerY >= 0.0 )
-                {
-                    v.y0 = 0.0;
-                    v.ry = c.radiusInnerY;
-                }
-                else
-                {
-                    v.y0 = c.radiusInnerY;
-                    v.ry = 0.0;
-                }
-
-                m_outer[ i ].x0 = m_outer[ i ].y0 = 0.0;
-                m_outer[ i ].rx = c.radiusX;
-                m_outer[ i ].ry = c.radiusY;
-            }
+            base[ i ] = center + sign * x0;
+            scale[ i ] = sign * r;
         }
 
-        inline void setAngle( qreal cos, qreal sin )
+        inline void setFactor( qreal factor )
         {
-            m_inner[ 0 ].setAngle( cos, sin );
-            m_inner[ 1 ].setAngle( cos, sin );
-            m_inner[ 2 ].setAngle( cos, sin );
-            m_inner[ 3 ].setAngle( cos, sin );
-
-            m_outer[ 0 ].setAngle( cos, sin );
-            if ( !m_uniform )
+#if defined( QSK_CORNER_VALUES_SSE2 )
+            if ( qskUseSimd )
             {
-                m_outer[ 1 ].setAngle( cos, sin );
-                m_outer[ 2 ].setAngle( cos, sin );
-                m_outer[ 3 ].setAngle( cos, sin );
-            }
-        }
+                const __m128d f = _mm_set1_pd( factor );
 
-        inline qreal dx1( int pos ) const { return m_inner[ pos].dx; }
+                _mm_store_pd( value, _mm_add_pd(
+                    _mm_load_pd( base ), _mm_mul_pd( f, _mm_load_pd( scale ) ) ) );
 
-        inline qreal dy1( int pos ) const { return m_inner[ pos ].dy; }
+                _mm_store_pd( value + 2, _mm_add_pd(
+                    _mm_load_pd( base + 2 ), _mm_mul_pd( f, _mm_load_pd( scale + 2 ) ) ) );
 
-        inline qreal dx2( int pos ) const
-            { return m_uniform ? m_outer[ 0 ].dx : m_outer[ pos ].dx; }
+                return;
+            }
+#elif defined( QSK_CORNER_VALUES_NEON )
+            if ( qskUseSimd )
+            {
+                const float64x2_t f = vdupq_n_f64( factor );
 
-        inline qreal dy2( int pos ) const
-            { return m_uniform ? m_outer[ 0 ].dy : m_outer[ pos ].dy; }
+                vst1q_f64( value, vfmaq_f64( vld1q_f64( base ), f, vld1q_f64( scale ) ) );
+                vst1q_f64( value + 2, vfmaq_f64( vld1q_f64( base + 2 ), f, vld1q_f64( scale + 2 ) ) );
 
-      private:
-        bool m_uniform;
-        class Values
-        {
-          public:
-            inline void setAngle( qreal cos, qreal sin )
-            {
-                dx = x0 + cos * rx;
-                dy = y0 + sin * ry;
+                return;
             }
+#endif
+            for ( int i = 0; i < 4; i++ )
+                value[ i ] = base[ i ] + factor * scale[ i ];
+        }
 
-            qreal dx, dy;
-            qreal x0, y0, rx, ry;
-        };
-
-        Values m_inner[ 4 ];
-        Values m_outer[ 4 ];
+        alignas( 16 ) qreal base[ 4 ];
+        alignas( 16 ) qreal scale[ 4 ];
+        alignas( 16 ) qreal value[ 4 ];
     };
 
-    class FillValues
+    class InnerValues
     {
       public:
-        inline FillValues( const QskBoxRenderer::Metrics& metrics )
+        inline InnerValues( const QskBoxRenderer::Metrics& metrics )
         {
             for ( int i = 0; i < 4; i++ )
             {
                 const auto& c = metrics.corner[ i ];
-                auto& v = m_inner[ i ];
 
                 if ( c.radiusInnerX >= 0.0 )
-                {
-                    v.x0 = 0.0;
-                    v.rx = c.radiusInnerX;
-                }
+                    m_x.setCorner( i, c.centerX, qskSignX( i ), 0.0, c.radiusInnerX );
                 else
-                {
-                    v.x0 = c.radiusInnerX;
-                    v.rx = 0.0;
-                }
+                    m_x.setCorner( i, c.centerX, qskSignX( i ), c.radiusInnerX, 0.0 );
 
                 if ( c.radiusInnerY >= 0.0 )
-                {
-                    v.y0 = 0.0;
-                    v.ry = c.radiusInnerY;
-                }
+                    m_y.setCorner( i, c.centerY, qskSignY( i ), 0.0, c.radiusInnerY );
                 else
-                {
-                    v.y0 = c.radiusInnerY;
-                    v.ry = 0.0;
-                }
+                    m_y.setCorner( i, c.centerY, qskSignY( i ), c.radiusInnerY, 0.0 );
             }
         }
 
         inline void setAngle( qreal cos, qreal sin )
         {
-            m_inner[ 0 ].setAngle( cos, sin );
-            m_inner[ 1 ].setAngle( cos, sin );
-            m_inner[ 2 ].setAngle( cos, sin );
-            m_inner[ 3 ].setAngle( cos, sin );
+            m_x.setFactor( cos );
+            m_y.setFactor( sin );
         }
 
-        inline qreal dx( int pos ) const { return m_inner[ pos ].dx; }
-        inline qreal dy( int pos ) const { return m_inner[ pos ].dy; }
+        inline qreal x( int pos ) const { return m_x.value[ pos ]; }
+        inline qreal y( int pos ) const { return m_y.value[ pos ]; }
 
       private:
-        class Values
+        CornerValues m_x;
+        CornerValues m_y;
+    };
+
+    class BorderValues
+    {
+      public:
+        inline BorderValues( const QskBoxRenderer::Metrics& metrics )
+            : m_inner( metrics )
         {
-          public:
-            inline void setAngle( qreal cos, qreal sin )
+            for ( int i = 0; i < 4; i++ )
             {
-                dx = x0 + cos * rx;
-                dy = y0 + sin * ry;
+                const auto& c = metrics.corner[ i ];
+
+                m_outerX.setCorner( i, c.centerX, qskSignX( i ), 0.0, c.radiusX );
+                m_outerY.setCorner( i, c.centerY, qskSignY( i ), 0.0, c.radiusY );
             }
+        }
+
+        inline void setAngle( qreal cos, qreal sin )
+        {
+            m_inner.setAngle( cos, sin );
+
+            m_outerX.setFactor( cos );
+            m_outerY.setFactor( sin );
+        }
 
-            qreal dx, dy;
-            qreal x0, y0, rx, ry;
-        };
+        inline qreal x1( int pos ) const { return m_inner.x( pos ); }
+        inline qreal y1( int pos ) const { return m_inner.y( pos ); }
 
-        Values m_inner[ 4 ];
+        inline qreal x2( int pos ) const { return m_outerX.value[ pos ]; }
+        inline qreal y2( int pos ) const { return m_outerY.value[ pos ]; }
+
+      private:
+        InnerValues m_inner;
+        CornerValues m_outerX;
+        CornerValues m_outerY;
     };
+
+    using FillValues = InnerValues;
 }
 
 namespace
@@ -380,15 +402,15 @@ namespace
 
             if ( m_arcIterator.isInverted() )
             {
-                m_v[ 1 ].left = c[ BottomLeft ].centerX - m_values.dx( BottomLeft );
-                m_v[ 1 ].right = c[ BottomRight ].centerX + m_values.dx( BottomRight );
-                m_v[ 1 ].y = c[ m_leadingCorner ].centerY + m_values.dy( m_leadingCorner );
+                m_v[ 1 ].left = m_values.x( BottomLeft );
+                m_v[ 1 ].right = m_values.x( BottomRight );
+                m_v[ 1 ].y = m_values.y( m_leadingCorner );
             }
             else
             {
-                m_v[ 1 ].left = c[ TopLeft ].centerX - m_values.dx( TopLeft );
-                m_v[ 1 ].right = c[ TopRight ].centerX + m_values.dx( TopRight );
-                m_v[ 1 ].y = c[ m_leadingCorner ].centerY - m_values.dy( m_leadingCorner );
+                m_v[ 1 ].left = m_values.x( TopLeft );
+                m_v[ 1 ].right = m_values.x( TopRight );
+                m_v[ 1 ].y = m_values.y( m_leadingCorner );
             }
 
             return true;
@@ -479,15 +501,15 @@ namespace
 
             if ( m_arcIterator.isInverted() )
             {
-                m_v[ 1 ].top = c[ TopLeft ].centerY - m_values.dy( TopLeft );
-                m_v[ 1 ].bottom = c[ BottomLeft ].centerY + m_values.dy( BottomLeft );
-                m_v[ 1 ].x = c[ m_leadingCorner ].centerX - m_values.dx( m_leadingCorner );
+                m_v[ 1 ].top = m_values.y( TopLeft );
+                m_v[ 1 ].bottom = m_values.y( BottomLeft );
+                m_v[ 1 ].x = m_values.x( m_leadingCorner );
             }
             else
             {
-                m_v[ 1 ].top = c[ TopRight ].centerY - m_values.dy( TopRight );
-                m_v[ 1 ].bottom = c[ BottomRight ].centerY + m_values.dy( BottomRight );
-                m_v[ 1 ].x = c[ m_leadingCorner ].centerX + m_values.dx( m_leadingCorner );
+                m_v[ 1 ].top = m_values.y( TopRight );
+                m_v[ 1 ].bottom = m_values.y( BottomRight );
+                m_v[ 1 ].x = m_values.x( m_leadingCorner );
             }
 
             return true;
@@ -661,49 +683,17 @@ namespace
                     const int j = it.step();
                     const int k = numCornerLines - it.step() - 1;
 
-                    {
-                        constexpr auto corner = TopLeft;
-
-                        linesTL[ j ].setLine(
-                            c[ corner ].centerX - v.dx1( corner ),
-                            c[ corner ].centerY - v.dy1( corner ),
-                            c[ corner ].centerX - v.dx2( corner ),
-                            c[ corner ].centerY - v.dy2( corner ),
-                            borderMapTL.colorAt( j ) );
-                    }
+                    linesTL[ j ].setLine( v.x1( TopLeft ), v.y1( TopLeft ),
+                        v.x2( TopLeft ), v.y2( TopLeft ), borderMapTL.colorAt( j ) );
 
-                    {
-                        constexpr auto corner = TopRight;
-
-                        linesTR[ k ].setLine(
-                            c[ corner ].centerX + v.dx1( corner ),
-                            c[ corner ].centerY - v.dy1( corner ),
-                            c[ corner ].centerX + v.dx2( corner ),
-                            c[ corner ].centerY - v.dy2( corner ),
-                            borderMapTR.colorAt( k ) );
-                    }
+                    linesTR[ k ].setLine( v.x1( TopRight ), v.y1( TopRight ),
+                        v.x2( TopRight ), v.y2( TopRight ), borderMapTR.colorAt( k ) );
 
-                    {
-                        constexpr auto corner = BottomLeft;
-
-                        linesBL[ k ].setLine(
-                            c[ corner ].centerX - v.dx1( corner ),
-                            c[ corner ].centerY + v.dy1( corner ),
-                            c[ corner ].centerX - v.dx2( corner ),
-                            c[ corner ].centerY + v.dy2( corner ),
-                            borderMapBL.colorAt( k ) );
-                    }
+                    linesBL[ k ].setLine( v.x1( BottomLeft ), v.y1( BottomLeft ),
+                        v.x2( BottomLeft ), v.y2( BottomLeft ), borderMapBL.colorAt( k ) );
 
-                    {
-                        constexpr auto corner = BottomRight;
-
-                        linesBR[ j ].setLine(
-                            c[ corner ].centerX + v.dx1( corner ),
-                            c[ corner ].centerY + v.dy1( corner ),
-                            c[ corner ].centerX + v.dx2( corner ),
-                            c[ corner ].centerY + v.dy2( corner ),
-                            borderMapBR.colorAt( j ) );
-                    }
+                    linesBR[ j ].setLine( v.x1( BottomRight ), v.y1( BottomRight ),
+                        v.x2( BottomRight ), v.y2( BottomRight ), borderMapBR.colorAt( j ) );
 
                     // at the beginning and end of the loop we can add
                     // additional lines for border gradients:
@@ -712,15 +702,15 @@ namespace
                     {
                         if( additionalGradientStops( borderMapTR.gradient() ) > 0 )
                         {
-                            float x1TR = c[ TopRight ].centerX + v.dx1( TopRight ),
-                                y1TR = c[ TopRight ].centerY - v.dy1( TopRight ),
-                                x2TR = c[ TopRight ].centerX + v.dx2( TopRight ),
-                                y2TR = c[ TopRight ].centerY - v.dy2( TopRight ),
+                            float x1TR = v.x1( TopRight ),
+                                y1TR = v.y1( TopRight ),
+                                x2TR = v.x2( TopRight ),
+                                y2TR = v.y2( TopRight ),
 
-                                x1TL = c[ TopLeft ].centerX - v.dx1( TopLeft ),
-                                y1TL = c[ TopLeft ].centerY - v.dy1( TopLeft ),
-                                x2TL = c[ TopLeft ].centerX - v.dx2( TopLeft ),
-                                y2TL = c[ TopLeft ].centerY - v.dy2( TopLeft );
+                                x1TL = v.x1( TopLeft ),
+                                y1TL = v.y1( TopLeft ),
+                                x2TL = v.x2( TopLeft ),
+                                y2TL = v.y2( TopLeft );
 
                             addAdditionalLines(
                                 x1TR, y1TR, x2TR, y2TR,
@@ -730,15 +720,15 @@ namespace
 
                         if( additionalGradientStops( borderMapBL.gradient() ) > 0 )
                         {
-                            float x1BL = c[ BottomLeft ].centerX - v.dx1( BottomLeft ),
-                                y1BL = c[ BottomLeft ].centerY + v.dy1( BottomLeft ),
-                                x2BL = c[ BottomLeft ].centerX - v.dx2( BottomLeft ),
-                                y2BL = c[ BottomLeft ].centerY + v.dy2( BottomLeft ),
+                            float x1BL = v.x1( BottomLeft ),
+                                y1BL = v.y1( BottomLeft ),
+                                x2BL = v.x2( BottomLeft ),
+                                y2BL = v.y2( BottomLeft ),
 
-                                x1BR = c[ BottomRight ].centerX + v.dx1( BottomRight ),
-                                y1BR = c[ BottomRight ].centerY + v.dy1( BottomRight ),
-                                x2BR = c[ BottomRight ].centerX + v.dx2( BottomRight ),
-                                y2BR = c[ BottomRight ].centerY + v.dy2( BottomRight );
+                                x1BR = v.x1( BottomRight ),
+                                y1BR = v.y1( BottomRight ),
+                                x2BR = v.x2( BottomRight ),
+                                y2BR = v.y2( BottomRight );
 
                             addAdditionalLines(
                                 x1BL, y1BL, x2BL, y2BL,
@@ -751,15 +741,15 @@ namespace
                     {
                         if( additionalGradientStops( borderMapTL.gradient() ) > 0 )
                         {
-                            float x1TL = c[ TopLeft ].centerX - v.dx1( TopLeft ),
-                                y1TL = c[ TopLeft ].centerY - v.dy1( TopLeft ),
-                                x2TL = c[ TopLeft ].centerX - v.dx2( TopLeft ),
-                                y2TL = c[ TopLeft ].centerY - v.dy2( TopLeft ),
+                            float x1TL = v.x1( TopLeft ),
+                                y1TL = v.y1( TopLeft ),
+                                x2TL = v.x2( TopLeft ),
+                                y2TL = v.y2( TopLeft ),
 
-                                x1BL = c[ BottomLeft ].centerX - v.dx1( BottomLeft ),
-                                y1BL = c[ BottomLeft ].centerY + v.dy1( BottomLeft ),
-                                x2BL = c[ BottomLeft ].centerX - v.dx2( BottomLeft ),
-                                y2BL = c[ BottomLeft ].centerY + v.dy2( BottomLeft );
+                                x1BL = v.x1( BottomLeft ),
+                                y1BL = v.y1( BottomLeft ),
+                                x2BL = v.x2( BottomLeft ),
+                                y2BL = v.y2( BottomLeft );
 
                             addAdditionalLines(
                                 x1TL, y1TL, x2TL, y2TL,
@@ -769,15 +759,15 @@ namespace
 
                         if( additionalGradientStops( borderMapBR.gradient() ) > 0 )
                         {
-                            float x1BR = c[ BottomRight ].centerX + v.dx1( BottomRight ),
-                                y1BR = c[ BottomRight ].centerY + v.dy1( BottomRight ),
-                                x2BR = c[ BottomRight ].centerX + v.dx2( BottomRight ),
-                                y2BR = c[ BottomRight ].centerY + v.dy2( BottomRight ),
+                            float x1BR = v.x1( BottomRight ),
+                                y1BR = v.y1( BottomRight ),
+                                x2BR = v.x2( BottomRight ),
+                                y2BR = v.y2( BottomRight ),
 
-                                x1TR = c[ TopRight ].centerX + v.dx1( TopRight ),
-                                y1TR = c[ TopRight ].centerY - v.dy1( TopRight ),
-                                x2TR = c[ TopRight ].centerX + v.dx2( TopRight ),
-                                y2TR = c[ TopRight ].centerY - v.dy2( TopRight );
+                                x1TR = v.x1( TopRight ),
+                                y1TR = v.y1( TopRight ),
+                                x2TR = v.x2( TopRight ),
+                                y2TR = v.y2( TopRight );
 
                             addAdditionalLines(
                                 x1BR, y1BR, x2BR, y2BR,
@@ -796,14 +786,14 @@ namespace
                         const int j = it.step();
                         const int k = numFillLines - it.step() - 1;
 
-                        const qreal x11 = c[ TopLeft ].centerX - v.dx1( TopLeft );
-                        const qreal x12 = c[ TopRight ].centerX + v.dx1( TopRight );
-                        const qreal y1 = c[ TopLeft ].centerY - v.dy1( TopLeft );
+                        const qreal x11 = v.x1( TopLeft );
+                        const qreal x12 = v.x1( TopRight );
+                        const qreal y1 = v.y1( TopLeft );
                         const auto c1 = fillMap.colorAt( ( y1 - ri.top ) / ri.height );
 
-                        const qreal x21 = c[ BottomLeft ].centerX - v.dx1( BottomLeft );
-                        const qreal x22 = c[ BottomRight ].centerX + v.dx1( BottomRight );
-                        const qreal y2 = c[ BottomLeft ].centerY + v.dy1( BottomLeft );
+                        const qreal x21 = v.x1( BottomLeft );
+                        const qreal x22 = v.x1( BottomRight );
+                        const qreal y2 = v.y1( BottomLeft );
                         const auto c2 = fillMap.colorAt( ( y2 - ri.top ) / ri.height );
 
                         fillLines[ j ].setLine( x11, y1, x12, y1, c1 );
@@ -814,14 +804,14 @@ namespace
                         const int j = stepCount - it.step();
                         const int k = numFillLines - 1 - stepCount + it.step();
 
-                        const qreal x1 = c[ TopLeft ].centerX - v.dx1( TopLeft );
-                        const qreal y11 = c[ TopLeft ].centerY - v.dy1( TopLeft );
-                        const qreal y12 = c[ BottomLeft ].centerY + v.dy1( BottomLeft );
+                        const qreal x1 = v.x1( TopLeft );
+                        const qreal y11 = v.y1( TopLeft );
+                        const qreal y12 = v.y1( BottomLeft );
                         const auto c1 = fillMap.colorAt( ( x1 - ri.left ) / ri.width );
 
-                        const qreal x2 = c[ TopRight ].centerX + v.dx1( TopRight );
-                        const qreal y21 = c[ TopRight ].centerY - v.dy1( TopRight );
-                        const qreal y22 = c[ BottomRight ].centerY + v.dy1( BottomRight );
+                        const qreal x2 = v.x1( TopRight );
+                        const qreal y21 = v.y1( TopRight );
+                        const qreal y22 = v.y1( BottomRight );
                         const auto c2 = fillMap.colorAt( ( x2 - ri.left ) / ri.width );
 
                         fillLines[ j ].setLine( x1, y11, x1, y12, c1 );
@@ -7,6 +7,14 @@
 #include "QskGraphic.h"
 #include "QskColorFilter.h"
 #include "QskPainterCommand.h"
+#include "QskTextureRenderer.h"
+
+static inline void qskRenderGraphic( QPainter* painter, const QSize& size,
+    const QskGraphic& graphic, const QskColorFilter& colorFilter )
+{
+    const QRectF rect( 0, 0, size.width(), size.height() );
+    graphic.render( painter, rect, colorFilter, Qt::IgnoreAspectRatio );
+}
 
 namespace
 {
@@ -16,10 +24,38 @@ namespace
         const QskGraphic& graphic;
         const QskColorFilter& colorFilter;
     };
+
+    class GraphicPaintHelper : public QskTextureRenderer::PaintHelper
+    {
+      public:
+        GraphicPaintHelper( const QskGraphic& graphic,
+                const QskColorFilter& colorFilter )
+            : m_graphic( graphic )
+            , m_colorFilter( colorFilter )
+        {
+        }
+
+        void paint( QPainter* painter, const QSize& size ) override
+        {
+            qskRenderGraphic( painter, size, m_graphic, m_colorFilter );
+        }
+
+      private:
+        // copies, as the helper is used after setGraphic has returned
+        const QskGraphic m_graphic;
+        const QskColorFilter m_colorFilter;
+    };
 }
 
 QskGraphicNode::QskGraphicNode()
 {
+    /*
+        Lists of buttons or menus usually display the same icons
+        over and over again. So we share the textures and pack the
+        small ones into the atlas, so that they can be batched.
+     */
+    setTextureSharing( true );
+    setAtlasLimit( 128 );
 }
 
 QskGraphicNode::~QskGraphicNode()
@@ -52,13 +88,14 @@ void QskGraphicNode::paint( QPainter* painter, const QSize& size, const void* no
     const auto& graphic = graphicData->graphic;
     const auto& colorFilter = graphicData->colorFilter;
 
-    if ( graphic.commandTypes() == QskGraphic::RasterData )
-    {
-        qDebug() << size;
-    }
+    qskRenderGraphic( painter, size, graphic, colorFilter );
+}
 
-    const QRectF rect( 0, 0, size.width(), size.height() );
-    graphic.render( painter, rect, colorFilter, Qt::IgnoreAspectRatio );
+QskTextureRenderer::PaintHelper* QskGraphicNode::createPaintHelper(
+    const void* nodeData ) const
+{
+    const auto graphicData = reinterpret_cast< const GraphicData* >( nodeData );
+    return new GraphicPaintHelper( graphicData->graphic, graphicData->colorFilter );
 }
 
 QskHashValue QskGraphicNode::hash( const void* nodeData ) const
@@ -4,13 +4,20 @@
  *****************************************************************************/
 
 #include "QskPaintedNode.h"
+#include "QskFrameStatistics.h"
 #include "QskSGNode.h"
+#include "QskTextureCache.h"
 #include "QskTextureRenderer.h"
 
+#include <qcoreapplication.h>
 #include <qsgimagenode.h>
 #include <qquickwindow.h>
 #include <qimage.h>
 #include <qpainter.h>
+#include <qmutex.h>
+#include <qpointer.h>
+#include <qrunnable.h>
+#include <qthreadpool.h>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qsgplaintexture_p.h>
@@ -41,14 +48,180 @@ namespace
 
         return static_cast< QSGImageNode* >( node );
     }
+
+    inline void releaseSharedTexture( const QSGImageNode* imageNode )
+    {
+        if ( imageNode && !imageNode->ownsTexture() )
+            QskTextureCache::release( imageNode->texture() );
+    }
+
+    class NodePaintHelper : public QskTextureRenderer::PaintHelper
+    {
+      public:
+        NodePaintHelper( QskPaintedNode* node, const void* nodeData )
+            : m_node( node )
+            , m_nodeData( nodeData )
+        {
+        }
+
+        void paint( QPainter* painter, const QSize& size ) override
+        {
+            m_node->paint( painter, size, m_nodeData );
+        }
+
+      private:
+        QskPaintedNode* m_node;
+        const void* m_nodeData;
+    };
+}
+
+static QImage qskPaintedImage( QskTextureRenderer::PaintHelper* helper,
+    const QSize& size, qreal devicePixelRatio )
+{
+    QImage image( size, QImage::Format_RGBA8888_Premultiplied );
+    image.fill( Qt::transparent );
+
+    QPainter painter( &image );
+
+    /*
+        setting a devicePixelRatio for the image only works for
+        value >= 1.0. So we have to scale manually.
+     */
+    painter.scale( devicePixelRatio, devicePixelRatio );
+
+    helper->paint( &painter, size / devicePixelRatio );
+
+    painter.end();
+
+    return image;
 }
 
+class QskPaintedNode::AsyncData
+{
+  public:
+    class Runnable;
+
+    // to be called from the GUI thread only
+    void updateWindow()
+    {
+        QPointer< QQuickWindow > window;
+
+        {
+            QMutexLocker locker( &mutex );
+            window = this->window;
+        }
+
+        if ( window )
+            window->update();
+    }
+
+    QMutex mutex;
+
+    // set, when synchronizing, and reset by the GUI thread
+    QPointer< QQuickWindow > window;
+    bool isCancelled = false;
+
+    // the latest request
+    QskHashValue hash = 0;
+    QSize size;
+    qreal devicePixelRatio = 1.0;
+
+    std::unique_ptr< QskTextureRenderer::PaintHelper > pendingHelper;
+    bool isRunning = false;
+
+    // the result, that has not been swapped in yet
+    QImage image;
+    bool hasImage = false;
+};
+
+class QskPaintedNode::AsyncData::Runnable : public QRunnable
+{
+  public:
+    Runnable( const std::shared_ptr< AsyncData >& data )
+        : m_data( data )
+    {
+    }
+
+    void run() override
+    {
+        auto& data = *m_data;
+
+        Q_FOREVER
+        {
+            std::unique_ptr< QskTextureRenderer::PaintHelper > helper;
+            QskHashValue hash;
+            QSize size;
+            qreal ratio;
+            const QQuickWindow* window; // a key for the statistics only
+
+            {
+                QMutexLocker locker( &data.mutex );
+
+                if ( data.isCancelled || data.pendingHelper == nullptr )
+                {
+                    data.isRunning = false;
+                    return;
+                }
+
+                helper = std::move( data.pendingHelper );
+                hash = data.hash;
+                size = data.size;
+                ratio = data.devicePixelRatio;
+                window = data.window;
+            }
+
+            const auto image = qskPaintedImage( helper.get(), size, ratio );
+
+            /*
+                Counting, when the image has been painted. It is swapped
+                in by preprocess(), what happens after the next sync
+                and would charge it to the frame after.
+             */
+            QskFrameStatistics::count( window, QskFrameStatistics::PaintedTextures );
+
+            QMutexLocker locker( &data.mutex );
+
+            if ( data.isCancelled )
+            {
+                data.isRunning = false;
+                return;
+            }
+
+            if ( data.pendingHelper == nullptr
+                && hash == data.hash && size == data.size )
+            {
+                data.image = image;
+                data.hasImage = true;
+
+                /*
+                    The image will be swapped in by QskPaintedNode::preprocess.
+                    The window might be deleted by the GUI thread at any time,
+                    so we don't touch it here, but post the update to
+                    the application object, that lives in the GUI thread.
+                 */
+                if ( auto app = QCoreApplication::instance() )
+                {
+                    const auto asyncData = m_data;
+
+                    QMetaObject::invokeMethod( app,
+                        [ asyncData ] { asyncData->updateWindow(); }, Qt::QueuedConnection );
+                }
+            }
+        }
+    }
+
+  private:
+    const std::shared_ptr< AsyncData > m_data;
+};
+
 QskPaintedNode::QskPaintedNode()
 {
 }
 
 QskPaintedNode::~QskPaintedNode()
 {
+    setAsynchronous( false );
+    releaseSharedTexture( findImageNode( this ) );
 }
 
 void QskPaintedNode::setRenderHint( RenderHint renderHint )
@@ -80,6 +253,77 @@ Qt::Orientations QskPaintedNode::mirrored() const
     return m_mirrored;
 }
 
+void QskPaintedNode::setTextureSharing( bool on )
+{
+    if ( on != m_textureSharing )
+    {
+        m_textureSharing = on;
+        m_hash = 0; // enforcing a texture update
+    }
+}
+
+bool QskPaintedNode::hasTextureSharing() const
+{
+    return m_textureSharing;
+}
+
+void QskPaintedNode::setAtlasLimit( int limit )
+{
+    limit = qMax( limit, 0 );
+
+    if ( limit != m_atlasLimit )
+    {
+        m_atlasLimit = limit;
+        m_hash = 0; // enforcing a texture update
+    }
+}
+
+int QskPaintedNode::atlasLimit() const
+{
+    return m_atlasLimit;
+}
+
+void QskPaintedNode::setAsynchronous( bool on )
+{
+    if ( on == isAsynchronous() )
+        return;
+
+    if ( on )
+    {
+        m_asyncData = std::make_shared< AsyncData >();
+        setFlag( QSGNode::UsePreprocess, true );
+    }
+    else
+    {
+        {
+            // a running worker might still use the data
+            QMutexLocker locker( &m_asyncData->mutex );
+
+            m_asyncData->isCancelled = true;
+            m_asyncData->pendingHelper.reset();
+        }
+
+        m_asyncData.reset();
+        setFlag( QSGNode::UsePreprocess, false );
+    }
+}
+
+bool QskPaintedNode::isAsynchronous() const
+{
+    return m_asyncData != nullptr;
+}
+
+QskTextureRenderer::PaintHelper* QskPaintedNode::createPaintHelper( const void* ) const
+{
+    return nullptr;
+}
+
+bool QskPaintedNode::isAtlasCandidate( const QSize& size ) const
+{
+    return ( m_atlasLimit > 0 )
+        && ( size.width() <= m_atlasLimit ) && ( size.height() <= m_atlasLimit );
+}
+
 QSize QskPaintedNode::textureSize() const
 {
     if ( const auto imageNode = findImageNode( this ) )
@@ -106,6 +350,8 @@ void QskPaintedNode::update( QQuickWindow* window,
     {
         if ( imageNode )
         {
+            releaseSharedTexture( imageNode );
+
             removeChildNode( imageNode );
             delete imageNode;
         }
@@ -145,7 +391,6 @@ void QskPaintedNode::update( QQuickWindow* window,
         isTextureDirty = ( imageSize != textureSize() );
     }
 
-
     if ( isTextureDirty )
         updateTexture( window, imageSize, nodeData );
 
@@ -157,8 +402,54 @@ void QskPaintedNode::update( QQuickWindow* window,
 void QskPaintedNode::updateTexture( QQuickWindow* window,
     const QSize& size, const void* nodeData )
 {
+    if ( m_asyncData )
+    {
+        if ( updateTextureAsync( window, size, nodeData ) )
+            return;
+
+        // results of pending requests would be outdated
+        QMutexLocker locker( &m_asyncData->mutex );
+
+        m_asyncData->pendingHelper.reset();
+        m_asyncData->hash = 0;
+        m_asyncData->size = QSize();
+        m_asyncData->image = QImage();
+        m_asyncData->hasImage = false;
+    }
+
+    if ( m_textureSharing && ( m_hash != 0 ) )
+    {
+        updateSharedTexture( window, size, nodeData );
+        return;
+    }
+
     auto imageNode = findImageNode( this );
 
+    if ( !imageNode->ownsTexture() )
+    {
+        // replacing a shared texture by a texture of our own
+
+        const auto sharedTexture = imageNode->texture();
+
+        imageNode->setTexture( createTexture( window, size, nodeData ) );
+        imageNode->setOwnsTexture( true );
+
+        QskTextureCache::release( sharedTexture );
+
+        return;
+    }
+
+    if ( isAtlasCandidate( size ) )
+    {
+        /*
+            Atlas textures can't be updated, so we always
+            create a new one. The image node deletes the
+            previous texture, releasing its area in the atlas.
+         */
+        imageNode->setTexture( createTexture( window, size, nodeData ) );
+        return;
+    }
+
     if ( ( m_renderHint == OpenGL ) && QskTextureRenderer::isOpenGLWindow( window ) )
     {
         const auto textureId = createTextureGL( window, size, nodeData );
@@ -186,50 +477,180 @@ void QskPaintedNode::updateTexture( QQuickWindow* window,
     }
 }
 
-QImage QskPaintedNode::createImage( QQuickWindow* window,
+void QskPaintedNode::updateSharedTexture( QQuickWindow* window,
     const QSize& size, const void* nodeData )
 {
-    QImage image( size, QImage::Format_RGBA8888_Premultiplied );
-    image.fill( Qt::transparent );
+    auto imageNode = findImageNode( this );
 
-    QPainter painter( &image );
+    auto cache = QskTextureCache::instance( window );
 
-    /*
-        setting a devicePixelRatio for the image only works for
-        value >= 1.0. So we have to scale manually.
-     */
-    const auto ratio = window->effectiveDevicePixelRatio();
-    painter.scale( ratio, ratio );
+    auto texture = cache->acquire( m_hash, size );
+    if ( texture == nullptr )
+    {
+        texture = cache->insert( m_hash, size,
+            createTexture( window, size, nodeData ) );
+    }
 
-    paint( &painter, size / ratio, nodeData );
+    const auto oldTexture = imageNode->texture();
 
-    painter.end();
+    if ( imageNode->ownsTexture() )
+    {
+        imageNode->setOwnsTexture( false );
+        imageNode->setTexture( texture );
 
-    return image;
+        delete oldTexture;
+    }
+    else
+    {
+        imageNode->setTexture( texture );
+        QskTextureCache::release( oldTexture );
+    }
 }
 
-quint32 QskPaintedNode::createTextureGL(
-    QQuickWindow* window, const QSize& size, const void* nodeData )
+bool QskPaintedNode::updateTextureAsync( QQuickWindow* window,
+    const QSize& size, const void* nodeData )
 {
-    class PaintHelper : public QskTextureRenderer::PaintHelper
+    auto imageNode = findImageNode( this );
+
+    if ( imageNode->texture() == nullptr || isAtlasCandidate( size ) )
     {
-      public:
-        PaintHelper( QskPaintedNode* node, const void* nodeData )
-            : m_node( node )
-            , m_nodeData( nodeData )
+        // nothing to display in the meantime or too small to be worth it
+        return false;
+    }
+
+    auto& data = *m_asyncData;
+
+    {
+        QMutexLocker locker( &data.mutex );
+
+        const bool isRequested = data.isRunning || data.pendingHelper || data.hasImage;
+
+        if ( isRequested && ( m_hash != 0 )
+            && ( m_hash == data.hash ) && ( size == data.size ) )
         {
+            return true;
         }
+    }
 
-        void paint( QPainter* painter, const QSize& size ) override
+    std::unique_ptr< QskTextureRenderer::PaintHelper > helper(
+        createPaintHelper( nodeData ) );
+
+    if ( helper == nullptr )
+        return false;
+
+    QMutexLocker locker( &data.mutex );
+
+    data.window = window;
+    data.hash = m_hash;
+    data.size = size;
+    data.devicePixelRatio = window->effectiveDevicePixelRatio();
+
+    // a previous request, that has not been started yet, is dropped
+    data.pendingHelper = std::move( helper );
+
+    data.image = QImage();
+    data.hasImage = false;
+
+    if ( !data.isRunning )
+    {
+        data.isRunning = true;
+        QThreadPool::globalInstance()->start( new AsyncData::Runnable( m_asyncData ) );
+    }
+
+    return true;
+}
+
+void QskPaintedNode::preprocess()
+{
+    if ( m_asyncData == nullptr )
+        return;
+
+    QImage image;
+    QQuickWindow* window = nullptr;
+
+    {
+        QMutexLocker locker( &m_asyncData->mutex );
+
+        if ( !m_asyncData->hasImage )
+            return;
+
+        image = m_asyncData->image;
+        window = m_asyncData->window;
+
+        m_asyncData->image = QImage();
+        m_asyncData->hasImage = false;
+    }
+
+    auto imageNode = findImageNode( this );
+    if ( imageNode == nullptr || window == nullptr )
+        return;
+
+    if ( imageNode->ownsTexture() )
+    {
+        if ( auto texture = qobject_cast< QSGPlainTexture* >( imageNode->texture() ) )
         {
-            m_node->paint( painter, size, m_nodeData );
+            texture->setImage( image );
+            imageNode->markDirty( QSGNode::DirtyMaterial );
+
+            return;
         }
 
-      private:
-        QskPaintedNode* m_node;
-        const void* m_nodeData;
-    };
+        imageNode->setTexture( window->createTextureFromImage( image ) );
+    }
+    else
+    {
+        const auto sharedTexture = imageNode->texture();
+
+        imageNode->setTexture( window->createTextureFromImage( image ) );
+        imageNode->setOwnsTexture( true );
+
+        QskTextureCache::release( sharedTexture );
+    }
+}
+
+QSGTexture* QskPaintedNode::createTexture( QQuickWindow* window,
+    const QSize& size, const void* nodeData )
+{
+    if ( isAtlasCandidate( size ) )
+    {
+        // the atlas is filled from images only
+
+        const auto image = createImage( window, size, nodeData );
+        return window->createTextureFromImage(
+            image, QQuickWindow::TextureCanUseAtlas );
+    }
+
+    if ( ( m_renderHint == OpenGL ) && QskTextureRenderer::isOpenGLWindow( window ) )
+    {
+        const auto textureId = createTextureGL( window, size, nodeData );
+
+        auto texture = new QSGPlainTexture;
+        texture->setHasAlphaChannel( true );
+        texture->setOwnsTexture( true );
+
+        QskTextureRenderer::setTextureId( window, textureId, size, texture );
+
+        return texture;
+    }
+
+    const auto image = createImage( window, size, nodeData );
+    return window->createTextureFromImage( image );
+}
+
+QImage QskPaintedNode::createImage( QQuickWindow* window,
+    const QSize& size, const void* nodeData )
+{
+    QskFrameStatistics::count( window, QskFrameStatistics::PaintedTextures );
+
+    NodePaintHelper helper( this, nodeData );
+    return qskPaintedImage( &helper, size, window->effectiveDevicePixelRatio() );
+}
+
+quint32 QskPaintedNode::createTextureGL(
+    QQuickWindow* window, const QSize& size, const void* nodeData )
+{
+    QskFrameStatistics::count( window, QskFrameStatistics::PaintedTextures );
 
-    PaintHelper helper( this, nodeData );
+    NodePaintHelper helper( this, nodeData );
     return createPaintedTextureGL( window, size, &helper );
 }
@@ -8,10 +8,17 @@
 
 #include "QskGlobal.h"
 #include <qsgnode.h>
+#include <memory>
 
 class QQuickWindow;
 class QPainter;
 class QImage;
+class QSGTexture;
+
+namespace QskTextureRenderer
+{
+    class PaintHelper;
+}
 
 class QSK_EXPORT QskPaintedNode : public QSGNode
 {
@@ -42,6 +49,43 @@ class QSK_EXPORT QskPaintedNode : public QSGNode
     void setMirrored( Qt::Orientations );
     Qt::Orientations mirrored() const;
 
+    /*
+        Nodes with identical content ( = hash ) and texture size might share
+        their texture. This is only possible, when the result of paint()
+        depends on the node data exclusively.
+     */
+    void setTextureSharing( bool );
+    bool hasTextureSharing() const;
+
+    /*
+        Textures, that do not exceed the atlas limit in width and height,
+        are rasterized and packed into the texture atlas of the scene graph.
+        Then the renderer is able to batch nodes, that would need
+        a draw call of their own otherwise. A limit of 0 disables
+        using the atlas.
+     */
+    void setAtlasLimit( int );
+    int atlasLimit() const;
+
+    /*
+        In asynchronous mode the image is rasterized by a worker thread,
+        while the node keeps on showing the previous texture. Once the
+        image is available it is swapped in. When the content changes
+        faster than the images can be painted, only the latest
+        request is processed.
+
+        Asynchronous painting is supported by nodes, that implement
+        createPaintHelper() only. Textures, that go into the atlas,
+        are always painted synchronously.
+
+        Asynchronous mode is disabled by default, as a node shows outdated
+        content for a couple of frames. It is intended to be enabled by
+        skinlets for nodes with large textures, f.e. a QskGraphicNode
+        for a fullscreen graphic.
+     */
+    void setAsynchronous( bool );
+    bool isAsynchronous() const;
+
     QRectF rect() const;
     QSize textureSize() const;
 
@@ -53,15 +97,35 @@ class QSK_EXPORT QskPaintedNode : public QSGNode
     // a hash value of '0' always results in repainting
     virtual QskHashValue hash( const void* nodeData ) const = 0;
 
+    /*
+        A helper, that paints the same as paint() without depending on
+        nodeData after returning. The default implementation returns nullptr.
+     */
+    virtual QskTextureRenderer::PaintHelper* createPaintHelper(
+        const void* nodeData ) const;
+
+    void preprocess() override;
+
   private:
+    class AsyncData;
+
     void updateTexture( QQuickWindow*, const QSize&, const void* nodeData );
+    void updateSharedTexture( QQuickWindow*, const QSize&, const void* nodeData );
+    bool updateTextureAsync( QQuickWindow*, const QSize&, const void* nodeData );
 
+    bool isAtlasCandidate( const QSize& ) const;
+
+    QSGTexture* createTexture( QQuickWindow*, const QSize&, const void* nodeData );
     QImage createImage( QQuickWindow*, const QSize&, const void* nodeData );
     quint32 createTextureGL( QQuickWindow*, const QSize&, const void* nodeData );
 
     RenderHint m_renderHint = OpenGL;
     Qt::Orientations m_mirrored;
     QskHashValue m_hash = 0;
+    int m_atlasLimit = 0;
+    bool m_textureSharing = false;
+
+    std::shared_ptr< AsyncData > m_asyncData;
 };
 
 #endif
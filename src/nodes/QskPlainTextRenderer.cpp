@@ -5,35 +5,243 @@
 
 #include "QskPlainTextRenderer.h"
 #include "QskTextColors.h"
+#include "QskTextLayoutCache.h"
 #include "QskTextOptions.h"
 
+#include <qcache.h>
 #include <qfontmetrics.h>
+#include <qglobalstatic.h>
 #include <qmath.h>
+#include <qmutex.h>
+#include <qrunnable.h>
+#include <qsemaphore.h>
 #include <qsgnode.h>
+#include <qstringlist.h>
+#include <qthreadpool.h>
+#include <qvector.h>
+
+#include <atomic>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qsgadaptationlayer_p.h>
 #include <private/qsgcontext_p.h>
 #include <private/qquickitem_p.h>
+#include <private/qguiapplication_p.h>
+#include <qpa/qplatformintegration.h>
 QSK_QT_PRIVATE_END
 
 #define GlyphFlag static_cast< QSGNode::Flag >( 0x800 )
 
+namespace
+{
+    class SizeKey
+    {
+      public:
+        SizeKey( const QString& text, const QFont& font,
+                const QskTextOptions& options, const QSizeF& size )
+            : text( text )
+            , font( font )
+            , options( options )
+            , size( size )
+        {
+            hash = qHash( text );
+            hash = qHash( font, hash );
+            hash = options.hash( hash );
+            hash = qHash( size.width(), hash );
+            hash = qHash( size.height(), hash );
+        }
+
+        inline bool operator==( const SizeKey& other ) const
+        {
+            return ( hash == other.hash ) && ( size == other.size )
+                && ( options == other.options ) && ( font == other.font )
+                && ( text == other.text );
+        }
+
+        QString text;
+        QFont font;
+        QskTextOptions options;
+        QSizeF size;
+
+        QskHashValue hash;
+    };
+
+    inline QskHashValue qHash( const SizeKey& key, QskHashValue seed = 0 )
+    {
+        return key.hash ^ seed;
+    }
+
+    class SizeCache
+    {
+      public:
+        /*
+            Preparing the sizes of the labels of a large view
+            is pointless, when the results have been dropped
+            before polishing
+         */
+        SizeCache()
+            : m_cache( 10000 )
+        {
+        }
+
+        inline bool find( const SizeKey& key, QRectF& rect )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            if ( const auto cachedRect = m_cache.object( key ) )
+            {
+                rect = *cachedRect;
+                return true;
+            }
+
+            return false;
+        }
+
+        inline bool contains( const SizeKey& key ) const
+        {
+            QMutexLocker locker( &m_mutex );
+            return m_cache.contains( key );
+        }
+
+        inline void insert( const SizeKey& key, const QRectF& rect )
+        {
+            QMutexLocker locker( &m_mutex );
+            m_cache.insert( key, new QRectF( rect ) );
+        }
+
+      private:
+        mutable QMutex m_mutex;
+        QCache< SizeKey, QRectF > m_cache;
+    };
+}
+
+/*
+    The sizes, that are needed for the size hints of labels: unconstrained
+    for the implicit sizes and for a given width/height for
+    the height/width for width/height hints.
+ */
+Q_GLOBAL_STATIC( SizeCache, qskSizeCache )
+
+// the size of unconstrained texts
+static const QSizeF qskMaxSize( 10e6, 10e6 );
+
+static inline QRectF qskMeasuredRect( const SizeKey& key )
+{
+    // result differs from QQuickText::implicitSizeHint ???
+
+    const QFontMetricsF fm( key.font );
+    const QRectF r( 0.0, 0.0, key.size.width(), key.size.height() );
+
+    return fm.boundingRect( r, key.options.textFlags(), key.text );
+}
+
+static QRectF qskTextRect( const QString& text, const QFont& font,
+    const QskTextOptions& options, const QSizeF& size )
+{
+    const SizeKey key( text, font, options, size );
+
+    QRectF rect;
+
+    if ( !qskSizeCache->find( key, rect ) )
+    {
+        rect = qskMeasuredRect( key );
+        qskSizeCache->insert( key, rect );
+    }
+
+    return rect;
+}
+
+namespace
+{
+    class SizeJob
+    {
+      public:
+        void run()
+        {
+            for ( int i = next++; i < keys.count(); i = next++ )
+                qskSizeCache->insert( keys[ i ], qskMeasuredRect( keys[ i ] ) );
+        }
+
+        QVector< SizeKey > keys;
+        std::atomic< int > next { 0 };
+
+        QSemaphore semaphore;
+    };
+
+    class SizeRunnable final : public QRunnable
+    {
+      public:
+        SizeRunnable( SizeJob* job )
+            : m_job( job )
+        {
+        }
+
+        void run() override
+        {
+            m_job->run();
+            m_job->semaphore.release();
+        }
+
+      private:
+        SizeJob* m_job;
+    };
+}
+
 QSizeF QskPlainTextRenderer::textSize(
     const QString& text, const QFont& font, const QskTextOptions& options )
 {
-    // result differs from QQuickText::implicitSizeHint ???
-    return textRect( text, font, options, QSizeF( 10e6, 10e6 ) ).size();
+    return qskTextRect( text, font, options, qskMaxSize ).size();
+}
+
+void QskPlainTextRenderer::prepareTextSizes( const QStringList& texts,
+    const QFont& font, const QskTextOptions& options, const QSizeF& size )
+{
+    const auto keySize = size.isValid() ? size : qskMaxSize;
+
+    SizeJob job;
+
+    for ( const auto& text : texts )
+    {
+        const SizeKey key( text, font, options, keySize );
+        if ( !qskSizeCache->contains( key ) )
+            job.keys += key;
+    }
+
+    if ( job.keys.isEmpty() )
+        return;
+
+    auto pool = QThreadPool::globalInstance();
+
+    const bool isThreaded = QGuiApplicationPrivate::platformIntegration()->hasCapability(
+        QPlatformIntegration::ThreadedFontRendering );
+
+    int runnableCount = 0;
+
+    if ( isThreaded )
+    {
+        const int maxCount = qMin( pool->maxThreadCount(), job.keys.count() - 1 );
+
+        for ( ; runnableCount < maxCount; runnableCount++ )
+        {
+            auto runnable = new SizeRunnable( &job );
+            if ( !pool->tryStart( runnable ) )
+            {
+                delete runnable;
+                break;
+            }
+        }
+    }
+
+    job.run();
+
+    job.semaphore.acquire( runnableCount );
 }
 
 QRectF QskPlainTextRenderer::textRect(
     const QString& text, const QFont& font, const QskTextOptions& options,
     const QSizeF& size )
 {
-    const QFontMetricsF fm( font );
-    const QRectF r( 0, 0, size.width(), size.height() );
-
-    return fm.boundingRect( r, options.textFlags(), text );
+    return qskTextRect( text, font, options, size );
 }
 
 static qreal qskLayoutText( QTextLayout* layout,
@@ -96,9 +304,54 @@ static qreal qskLayoutText( QTextLayout* layout,
     return y;
 }
 
+static QskTextLayoutCache::Layout qskShapedText( const QString& text,
+    const QFont& font, const QskTextOptions& options,
+    Qt::Alignment alignment, qreal lineWidth )
+{
+    QTextOption textOption( alignment );
+    textOption.setWrapMode( static_cast< QTextOption::WrapMode >( options.wrapMode() ) );
+
+    QString tmp = text;
+
+#if 0
+    const int pos = tmp.indexOf( QLatin1Char( '\x9c' ) );
+    if ( pos != -1 )
+    {
+        // ST: string termination
+
+        tmp = tmp.mid( 0, pos );
+        tmp.replace( QLatin1Char( '\n' ), QChar::LineSeparator );
+    }
+    else
+#endif
+    if ( tmp.contains( QLatin1Char( '\n' ) ) )
+    {
+        tmp.replace( QLatin1Char('\n'), QChar::LineSeparator );
+    }
+
+    QTextLayout layout;
+    layout.setFont( font );
+    layout.setTextOption( textOption );
+    layout.setText( tmp );
+
+    QskTextLayoutCache::Layout textLayout;
+
+    layout.beginLayout();
+    textLayout.textHeight = qskLayoutText( &layout, lineWidth, options );
+    layout.endLayout();
+
+    textLayout.boundingHeight = layout.boundingRect().height();
+
+    for ( int i = 0; i < layout.lineCount(); ++i )
+        textLayout.glyphRuns += layout.lineAt( i ).glyphRuns();
+
+    return textLayout;
+}
+
 static void qskRenderText(
-    QQuickItem* item, QSGNode* parentNode, const QTextLayout& layout, qreal baseLine,
-    const QColor& color, QQuickText::TextStyle style, const QColor& styleColor )
+    QQuickItem* item, QSGNode* parentNode, const QList< QGlyphRun >& glyphRuns,
+    qreal baseLine, const QColor& color, QQuickText::TextStyle style,
+    const QColor& styleColor )
 {
     auto renderContext = QQuickItemPrivate::get(item)->sceneGraphRenderContext();
     auto sgContext = renderContext->sceneGraphContext();
@@ -120,39 +373,34 @@ static void qskRenderText(
 
     const QPointF position( 0, baseLine );
 
-    for ( int i = 0; i < layout.lineCount(); ++i )
+    for ( const auto& glyphRun : glyphRuns )
     {
-        const auto glyphRuns = layout.lineAt( i ).glyphRuns();
-
-        for ( const auto& glyphRun : glyphRuns )
+        if ( glyphNode == nullptr )
         {
-            if ( glyphNode == nullptr )
-            {
-                const bool preferNativeGlyphNode = false; // QskTextOptions?
+            const bool preferNativeGlyphNode = false; // QskTextOptions?
 
 #if QT_VERSION >= QT_VERSION_CHECK( 6, 0, 0 )
-                constexpr int renderQuality = -1; // QQuickText::DefaultRenderTypeQuality
-                glyphNode = sgContext->createGlyphNode(
-                    renderContext, preferNativeGlyphNode, renderQuality );
+            constexpr int renderQuality = -1; // QQuickText::DefaultRenderTypeQuality
+            glyphNode = sgContext->createGlyphNode(
+                renderContext, preferNativeGlyphNode, renderQuality );
 #else
-                glyphNode = sgContext->createGlyphNode(
-                    renderContext, preferNativeGlyphNode );
+            glyphNode = sgContext->createGlyphNode(
+                renderContext, preferNativeGlyphNode );
 #endif
-                glyphNode->setOwnerElement( item );
-                glyphNode->setFlags( QSGNode::OwnedByParent | GlyphFlag );
-            }
+            glyphNode->setOwnerElement( item );
+            glyphNode->setFlags( QSGNode::OwnedByParent | GlyphFlag );
+        }
 
-            glyphNode->setStyle( style );
-            glyphNode->setColor( color );
-            glyphNode->setStyleColor( styleColor );
-            glyphNode->setGlyphs( position, glyphRun );
-            glyphNode->update();
+        glyphNode->setStyle( style );
+        glyphNode->setColor( color );
+        glyphNode->setStyleColor( styleColor );
+        glyphNode->setGlyphs( position, glyphRun );
+        glyphNode->update();
 
-            if ( glyphNode->parent() != parentNode )
-                parentNode->appendChildNode( glyphNode );
+        if ( glyphNode->parent() != parentNode )
+            parentNode->appendChildNode( glyphNode );
 
-            glyphNode = static_cast< QSGGlyphNode* >( glyphNode->nextSibling() );
-        }
+        glyphNode = static_cast< QSGGlyphNode* >( glyphNode->nextSibling() );
     }
 
     // Remove leftover glyphs
@@ -174,36 +422,30 @@ void QskPlainTextRenderer::updateNode( const QString& text,
     Qt::Alignment alignment, const QRectF& rect,
     const QQuickItem* item, QSGTransformNode* node )
 {
-    QTextOption textOption( alignment );
-    textOption.setWrapMode( static_cast< QTextOption::WrapMode >( options.wrapMode() ) );
-
-    QString tmp = text;
-
-#if 0
-    const int pos = tmp.indexOf( QLatin1Char( '\x9c' ) );
-    if ( pos != -1 )
+    /*
+        Shaping is expensive, so we reuse the glyph runs of texts,
+        that have been laid out before. The vertical alignment is
+        applied below and is not part of the key.
+     */
+    QskTextLayoutCache::Key key;
+    key.text = text;
+    key.font = font;
+    key.options = options;
+    key.alignment = alignment & Qt::AlignHorizontal_Mask;
+    key.width = rect.width();
+
+    QskTextLayoutCache::Layout layout;
+
+    auto cache = QskTextLayoutCache::instance( item->window() );
+    if ( cache == nullptr || !cache->find( key, layout ) )
     {
-        // ST: string termination
+        layout = qskShapedText( text, font, options, key.alignment, key.width );
 
-        tmp = tmp.mid( 0, pos );
-        tmp.replace( QLatin1Char( '\n' ), QChar::LineSeparator );
-    }
-    else
-#endif
-    if ( tmp.contains( QLatin1Char( '\n' ) ) )
-    {
-        tmp.replace( QLatin1Char('\n'), QChar::LineSeparator );
+        if ( cache )
+            cache->insert( key, layout );
     }
 
-
-    QTextLayout layout;
-    layout.setFont( font );
-    layout.setTextOption( textOption );
-    layout.setText( tmp );
-
-    layout.beginLayout();
-    const qreal textHeight = qskLayoutText( &layout, rect.width(), options );
-    layout.endLayout();
+    const qreal textHeight = layout.textHeight;
 
     const qreal y0 = QFontMetricsF( font ).ascent();
 
@@ -226,12 +468,12 @@ void QskPlainTextRenderer::updateNode( const QString& text,
             between margins/paddings.
          */
 
-        const int bh = int( layout.boundingRect().height() );
+        const int bh = int( layout.boundingHeight );
         yBaseline = ( bh % 2 ) ? qFloor( yBaseline ) : qCeil( yBaseline );
     }
 
     qskRenderText(
-        const_cast< QQuickItem* >( item ), node, layout, yBaseline,
+        const_cast< QQuickItem* >( item ), node, layout.glyphRuns, yBaseline,
         colors.textColor, static_cast< QQuickText::TextStyle >( style ),
         colors.styleColor );
 }
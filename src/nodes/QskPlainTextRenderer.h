@@ -8,14 +8,15 @@
 
 #include "QskNamespace.h"
 #include <qnamespace.h>
+#include <qsize.h>
 
 class QskTextColors;
 class QskTextOptions;
 
 class QString;
+class QStringList;
 class QFont;
 class QRectF;
-class QSizeF;
 class QQuickItem;
 class QColor;
 class QSGTransformNode;
@@ -37,6 +38,10 @@ namespace QskPlainTextRenderer
 
     QSK_EXPORT QRectF textRect( const QString&,
         const QFont&, const QskTextOptions&, const QSizeF& );
+
+    // see QskRichTextRenderer::prepareTextSizes
+    QSK_EXPORT void prepareTextSizes( const QStringList&,
+        const QFont&, const QskTextOptions&, const QSizeF& = QSizeF() );
 }
 
 #endif
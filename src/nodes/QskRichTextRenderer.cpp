@@ -7,15 +7,24 @@
 #include "QskTextColors.h"
 #include "QskTextOptions.h"
 
+#include <qcache.h>
 #include <qglobalstatic.h>
 #include <qmutex.h>
+#include <qrunnable.h>
+#include <qsemaphore.h>
 #include <qthread.h>
+#include <qthreadpool.h>
+#include <qvector.h>
+
+#include <atomic>
 
 class QQuickWindow;
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qquicktext_p.h>
 #include <private/qquicktext_p_p.h>
+#include <private/qguiapplication_p.h>
+#include <qpa/qplatformintegration.h>
 QSK_QT_PRIVATE_END
 
 // Since Qt 5.7 QQuickTextNode is public and could be used TODO ...
@@ -188,52 +197,247 @@ namespace
  */
 Q_GLOBAL_STATIC( TextItemMap, qskTextItemMap )
 
-QSizeF QskRichTextRenderer::textSize(
-    const QString& text, const QFont& font, const QskTextOptions& options )
+namespace
+{
+    class SizeKey
+    {
+      public:
+        SizeKey( const QString& text, const QFont& font,
+                const QskTextOptions& options, const QSizeF& size )
+            : text( text )
+            , font( font )
+            , options( options )
+            , size( size )
+        {
+            hash = qHash( text );
+            hash = qHash( font, hash );
+            hash = options.hash( hash );
+            hash = qHash( size.width(), hash );
+            hash = qHash( size.height(), hash );
+        }
+
+        inline bool isConstrained() const
+        {
+            return size.width() >= 0.0;
+        }
+
+        inline bool operator==( const SizeKey& other ) const
+        {
+            return ( hash == other.hash ) && ( size == other.size )
+                && ( options == other.options ) && ( font == other.font )
+                && ( text == other.text );
+        }
+
+        QString text;
+        QFont font;
+        QskTextOptions options;
+        QSizeF size; // invalid for unconstrained texts
+
+        QskHashValue hash;
+    };
+
+    inline QskHashValue qHash( const SizeKey& key, QskHashValue seed = 0 )
+    {
+        return key.hash ^ seed;
+    }
+
+    class SizeCache
+    {
+      public:
+        SizeCache()
+            : m_cache( 2000 )
+        {
+        }
+
+        inline bool find( const SizeKey& key, QRectF& rect )
+        {
+            QMutexLocker locker( &m_mutex );
+
+            if ( const auto cachedRect = m_cache.object( key ) )
+            {
+                rect = *cachedRect;
+                return true;
+            }
+
+            return false;
+        }
+
+        inline bool contains( const SizeKey& key ) const
+        {
+            QMutexLocker locker( &m_mutex );
+            return m_cache.contains( key );
+        }
+
+        inline void insert( const SizeKey& key, const QRectF& rect )
+        {
+            QMutexLocker locker( &m_mutex );
+            m_cache.insert( key, new QRectF( rect ) );
+        }
+
+      private:
+        mutable QMutex m_mutex;
+        QCache< SizeKey, QRectF > m_cache;
+    };
+}
+
+Q_GLOBAL_STATIC( SizeCache, qskSizeCache )
+
+/*
+    Measuring is done with the same QQuickText items, that are used
+    for rendering, so that formats, elide modes and the font size mode
+    are respected in the same way. As the items are created for each
+    thread, texts can be measured in parallel.
+ */
+static QRectF qskMeasuredRect( const SizeKey& key )
 {
     auto& textItem = *qskTextItemMap->item();
 
     textItem.begin();
 
-    textItem.setFont( font );
-    textItem.setOptions( options );
+    textItem.setFont( key.font );
+    textItem.setOptions( key.options );
 
-    textItem.setWidth( -1 );
-    textItem.setText( text );
+    QRectF rect;
 
-    textItem.end();
+    if ( key.isConstrained() )
+    {
+        textItem.setAlignment( Qt::Alignment() );
+
+        textItem.setWidth( key.size.width() );
+        textItem.setHeight( key.size.height() );
+
+        textItem.setText( key.text );
+
+        textItem.end();
+
+        rect = textItem.layedOutTextRect();
+    }
+    else
+    {
+        textItem.setWidth( -1 );
+        textItem.setText( key.text );
 
-    const QSizeF sz( textItem.implicitWidth(), textItem.implicitHeight() );
+        textItem.end();
+
+        rect = QRectF( 0.0, 0.0, textItem.implicitWidth(), textItem.implicitHeight() );
+    }
 
     textItem.reset();
 
-    return sz;
+    return rect;
+}
+
+static QRectF qskTextRect( const QString& text, const QFont& font,
+    const QskTextOptions& options, const QSizeF& size )
+{
+    const SizeKey key( text, font, options, size );
+
+    QRectF rect;
+
+    if ( !qskSizeCache->find( key, rect ) )
+    {
+        rect = qskMeasuredRect( key );
+        qskSizeCache->insert( key, rect );
+    }
+
+    return rect;
+}
+
+namespace
+{
+    class SizeJob
+    {
+      public:
+        void run()
+        {
+            for ( int i = next++; i < keys.count(); i = next++ )
+                qskSizeCache->insert( keys[ i ], qskMeasuredRect( keys[ i ] ) );
+        }
+
+        QVector< SizeKey > keys;
+        std::atomic< int > next { 0 };
+
+        QSemaphore semaphore;
+    };
+
+    class SizeRunnable final : public QRunnable
+    {
+      public:
+        SizeRunnable( SizeJob* job )
+            : m_job( job )
+        {
+        }
+
+        void run() override
+        {
+            m_job->run();
+            m_job->semaphore.release();
+        }
+
+      private:
+        SizeJob* m_job;
+    };
+}
+
+QSizeF QskRichTextRenderer::textSize(
+    const QString& text, const QFont& font, const QskTextOptions& options )
+{
+    return qskTextRect( text, font, options, QSizeF() ).size();
 }
 
 QRectF QskRichTextRenderer::textRect(
     const QString& text, const QFont& font,
     const QskTextOptions& options, const QSizeF& size )
 {
-    auto& textItem = *qskTextItemMap->item();
+    return qskTextRect( text, font, options, size );
+}
 
-    textItem.begin();
+void QskRichTextRenderer::prepareTextSizes( const QStringList& texts,
+    const QFont& font, const QskTextOptions& options, const QSizeF& size )
+{
+    SizeJob job;
 
-    textItem.setFont( font );
-    textItem.setOptions( options );
-    textItem.setAlignment( Qt::Alignment() );
+    for ( const auto& text : texts )
+    {
+        const SizeKey key( text, font, options, size );
+        if ( !qskSizeCache->contains( key ) )
+            job.keys += key;
+    }
 
-    textItem.setWidth( size.width() );
-    textItem.setHeight( size.height() );
+    if ( job.keys.isEmpty() )
+        return;
 
-    textItem.setText( text );
+    auto pool = QThreadPool::globalInstance();
 
-    textItem.end();
+    /*
+        Fonts can only be used outside of the GUI thread,
+        when the platform supports it.
+     */
+    const bool isThreaded = QGuiApplicationPrivate::platformIntegration()->hasCapability(
+        QPlatformIntegration::ThreadedFontRendering );
 
-    const auto rect = textItem.layedOutTextRect();
+    int runnableCount = 0;
 
-    textItem.reset();
+    if ( isThreaded )
+    {
+        // using idle threads only, so that we never wait for other tasks
+        const int maxCount = qMin( pool->maxThreadCount(), job.keys.count() - 1 );
 
-    return rect;
+        for ( ; runnableCount < maxCount; runnableCount++ )
+        {
+            auto runnable = new SizeRunnable( &job );
+            if ( !pool->tryStart( runnable ) )
+            {
+                delete runnable;
+                break;
+            }
+        }
+    }
+
+    // the calling thread is measuring as well
+    job.run();
+
+    job.semaphore.acquire( runnableCount );
 }
 
 void QskRichTextRenderer::updateNode(
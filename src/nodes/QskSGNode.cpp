@@ -4,14 +4,17 @@
  *****************************************************************************/
 
 #include "QskSGNode.h"
+#include "QskFrameStatistics.h"
 
 static inline void qskRemoveChildNode( QSGNode* parent, QSGNode* child )
 {
     parent->removeChildNode( child );
 
     if ( child->flags() & QSGNode::OwnedByParent )
+    {
         delete child;
-
+        QskFrameStatistics::count( QskFrameStatistics::DestroyedNodes );
+    }
 }
 
 static inline void qskRemoveAllChildNodesAfter( QSGNode* parent, QSGNode* child )
@@ -132,6 +135,8 @@ void QskSGNode::replaceChildNode(
 {
     if ( newNode && newNode->parent() != parentNode )
     {
+        QskFrameStatistics::count( QskFrameStatistics::CreatedNodes );
+
         setNodeRole( newNode, role );
 
         switch ( role )
@@ -161,8 +166,6 @@ void QskSGNode::replaceChildNode(
 
     if ( oldNode && oldNode != newNode )
     {
-        parentNode->removeChildNode( oldNode );
-        if ( oldNode->flags() & QSGNode::OwnedByParent )
-            delete oldNode;
+        qskRemoveChildNode( parentNode, oldNode );
     }
 }
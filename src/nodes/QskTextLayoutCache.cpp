@@ -0,0 +1,256 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskTextLayoutCache.h"
+
+#include <qhash.h>
+#include <qmutex.h>
+#include <qquickwindow.h>
+
+#include <list>
+#include <unordered_map>
+
+namespace
+{
+    using Key = QskTextLayoutCache::Key;
+
+    class KeyHash
+    {
+      public:
+        inline size_t operator()( const Key& key ) const
+        {
+            return key.hash();
+        }
+    };
+
+    using EntryList = std::list< const Key* >;
+
+    class Entry
+    {
+      public:
+        QskTextLayoutCache::Layout layout;
+
+        // position in the list of entries, the most recently used one in front
+        EntryList::iterator pos;
+    };
+
+    class CacheMap
+    {
+      public:
+        ~CacheMap()
+        {
+            qDeleteAll( caches );
+        }
+
+        QMutex mutex;
+        QHash< const QQuickWindow*, QskTextLayoutCache* > caches;
+    };
+}
+
+Q_GLOBAL_STATIC( CacheMap, qskCacheMap )
+
+bool QskTextLayoutCache::Key::operator==( const Key& other ) const noexcept
+{
+    return ( width == other.width ) && ( alignment == other.alignment )
+        && ( options == other.options ) && ( font == other.font )
+        && ( text == other.text );
+}
+
+QskHashValue QskTextLayoutCache::Key::hash( QskHashValue seed ) const noexcept
+{
+    auto hash = qHash( text, seed );
+    hash = qHash( font, hash );
+    hash = options.hash( hash );
+    hash = qHash( alignment, hash );
+    hash = qHash( width, hash );
+
+    return hash;
+}
+
+class QskTextLayoutCache::PrivateData
+{
+  public:
+    // the statistics might be requested from the GUI thread
+    mutable QMutex mutex;
+
+    std::unordered_map< Key, Entry, KeyHash > entries;
+    EntryList usedEntries;
+
+    int maxCount = 2000;
+    Statistics statistics;
+};
+
+QskTextLayoutCache::QskTextLayoutCache( const QQuickWindow* window )
+    : m_data( new PrivateData() )
+{
+    /*
+        A new scene graph might be initialized from a different thread,
+        so the glyph runs of the previous one are dropped.
+     */
+    QObject::connect( window, &QQuickWindow::sceneGraphInvalidated,
+        [ this ] { clear(); } );
+
+    QObject::connect( window, &QObject::destroyed,
+        [ window ]
+        {
+            QskTextLayoutCache* cache = nullptr;
+
+            if ( qskCacheMap )
+            {
+                QMutexLocker locker( &qskCacheMap->mutex );
+                cache = qskCacheMap->caches.take( window );
+            }
+
+            delete cache;
+        } );
+}
+
+QskTextLayoutCache::~QskTextLayoutCache()
+{
+}
+
+QskTextLayoutCache* QskTextLayoutCache::instance( const QQuickWindow* window )
+{
+    if ( window == nullptr || !qskCacheMap )
+        return nullptr;
+
+    QMutexLocker locker( &qskCacheMap->mutex );
+
+    auto& cache = qskCacheMap->caches[ window ];
+    if ( cache == nullptr )
+        cache = new QskTextLayoutCache( window );
+
+    return cache;
+}
+
+void QskTextLayoutCache::setMaxCount( int count )
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    m_data->maxCount = qMax( count, 0 );
+    evict();
+}
+
+int QskTextLayoutCache::maxCount() const
+{
+    QMutexLocker locker( &m_data->mutex );
+    return m_data->maxCount;
+}
+
+bool QskTextLayoutCache::find( const Key& key, Layout& layout )
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    auto it = m_data->entries.find( key );
+    if ( it == m_data->entries.end() )
+    {
+        m_data->statistics.misses++;
+        return false;
+    }
+
+    m_data->statistics.hits++;
+
+    auto& entry = it->second;
+
+    auto& usedEntries = m_data->usedEntries;
+    usedEntries.splice( usedEntries.begin(), usedEntries, entry.pos );
+
+    // QGlyphRun is implicitly shared
+    layout = entry.layout;
+
+    return true;
+}
+
+void QskTextLayoutCache::insert( const Key& key, const Layout& layout )
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    if ( m_data->maxCount <= 0 )
+        return;
+
+    auto result = m_data->entries.emplace( key, Entry() );
+
+    auto& entry = result.first->second;
+    entry.layout = layout;
+
+    auto& usedEntries = m_data->usedEntries;
+
+    if ( result.second )
+    {
+        // the key stored in the map stays valid until the entry is erased
+        usedEntries.push_front( &result.first->first );
+        entry.pos = usedEntries.begin();
+
+        m_data->statistics.count++;
+        evict();
+    }
+    else
+    {
+        usedEntries.splice( usedEntries.begin(), usedEntries, entry.pos );
+    }
+}
+
+void QskTextLayoutCache::evict()
+{
+    auto& statistics = m_data->statistics;
+
+    while ( statistics.count > m_data->maxCount )
+    {
+        const auto key = m_data->usedEntries.back();
+        m_data->usedEntries.pop_back();
+
+        // the key is owned by the entry: erasing by iterator
+        m_data->entries.erase( m_data->entries.find( *key ) );
+
+        statistics.count--;
+        statistics.evictions++;
+    }
+}
+
+void QskTextLayoutCache::clear()
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    m_data->usedEntries.clear();
+    m_data->entries.clear();
+
+    m_data->statistics.count = 0;
+}
+
+QskTextLayoutCache::Statistics QskTextLayoutCache::statistics() const
+{
+    QMutexLocker locker( &m_data->mutex );
+    return m_data->statistics;
+}
+
+void QskTextLayoutCache::resetStatistics()
+{
+    QMutexLocker locker( &m_data->mutex );
+
+    auto& statistics = m_data->statistics;
+    statistics.hits = statistics.misses = statistics.evictions = 0;
+}
+
+#ifndef QT_NO_DEBUG_STREAM
+
+#include <qdebug.h>
+
+QDebug operator<<( QDebug debug, const QskTextLayoutCache::Statistics& statistics )
+{
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << "QskTextLayoutCache" << '(';
+    debug << "layouts: " << statistics.count
+          << ", hits: " << statistics.hits
+          << ", misses: " << statistics.misses
+          << ", hitRate: " << statistics.hitRate()
+          << ", evictions: " << statistics.evictions;
+    debug << ')';
+
+    return debug;
+}
+
+#endif
@@ -0,0 +1,108 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_TEXT_LAYOUT_CACHE_H
+#define QSK_TEXT_LAYOUT_CACHE_H
+
+#include "QskTextOptions.h"
+
+#include <qfont.h>
+#include <qglyphrun.h>
+#include <qlist.h>
+#include <qstring.h>
+
+#include <memory>
+
+class QQuickWindow;
+
+/*
+    QskTextLayoutCache stores the glyph runs of texts, that have been shaped
+    by QskPlainTextRenderer. This avoids shaping the same texts over and over,
+    when scrolling back and forth in long lists.
+
+    The positions of the glyphs are relative to the baseline of the first line,
+    so that the same layout can be used for different vertical alignments.
+    The least recently used layouts are evicted first, when the maximum
+    number of entries is exceeded.
+
+    Glyph runs refer to raw fonts, that belong to the font engines of the
+    thread, that did the shaping. So each window has a cache of its own,
+    that is used from its scene graph thread only. It is cleared, when the
+    scene graph gets invalidated, and deleted together with the window.
+ */
+class QSK_EXPORT QskTextLayoutCache
+{
+  public:
+    class Key
+    {
+      public:
+        bool operator==( const Key& ) const noexcept;
+        QskHashValue hash( QskHashValue seed = 0 ) const noexcept;
+
+        QString text;
+        QFont font;
+        QskTextOptions options;
+        Qt::Alignment alignment;
+        qreal width = 0.0;
+    };
+
+    class Layout
+    {
+      public:
+        QList< QGlyphRun > glyphRuns;
+
+        qreal textHeight = 0.0;
+        qreal boundingHeight = 0.0;
+    };
+
+    class Statistics
+    {
+      public:
+        inline qreal hitRate() const
+        {
+            const auto lookups = hits + misses;
+            return lookups ? qreal( hits ) / lookups : 0.0;
+        }
+
+        int count = 0;
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+    };
+
+    static QskTextLayoutCache* instance( const QQuickWindow* );
+
+    void setMaxCount( int );
+    int maxCount() const;
+
+    bool find( const Key&, Layout& );
+    void insert( const Key&, const Layout& );
+
+    void clear();
+
+    Statistics statistics() const;
+    void resetStatistics();
+
+  private:
+    QskTextLayoutCache( const QQuickWindow* );
+    ~QskTextLayoutCache();
+
+    Q_DISABLE_COPY( QskTextLayoutCache )
+
+    void evict();
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#ifndef QT_NO_DEBUG_STREAM
+
+class QDebug;
+QSK_EXPORT QDebug operator<<( QDebug, const QskTextLayoutCache::Statistics& );
+
+#endif
+
+#endif
@@ -9,6 +9,7 @@
 #include "QskTextOptions.h"
 
 #include <qrect.h>
+#include <qstringlist.h>
 
 /*
     Since Qt 5.7 QQuickTextNode is exported as Q_QUICK_PRIVATE_EXPORT
@@ -33,6 +34,27 @@ QSizeF QskTextRenderer::textSize(
         return QskRichTextRenderer::textRect( text, font, options, size ).size();
 }
 
+void QskTextRenderer::prepareTextSizes( const QStringList& texts,
+    const QFont& font, const QskTextOptions& options, const QSizeF& size )
+{
+    QStringList plainTexts;
+    QStringList richTexts;
+
+    for ( const auto& text : texts )
+    {
+        if ( options.effectiveFormat( text ) == QskTextOptions::PlainText )
+            plainTexts += text;
+        else
+            richTexts += text;
+    }
+
+    if ( !plainTexts.isEmpty() )
+        QskPlainTextRenderer::prepareTextSizes( plainTexts, font, options, size );
+
+    if ( !richTexts.isEmpty() )
+        QskRichTextRenderer::prepareTextSizes( richTexts, font, options, size );
+}
+
 void QskTextRenderer::updateNode(
     const QString& text, const QFont& font, const QskTextOptions& options,
     Qsk::TextStyle style, const QskTextColors& colors, Qt::Alignment alignment,
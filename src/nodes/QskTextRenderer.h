@@ -8,14 +8,15 @@
 
 #include "QskNamespace.h"
 #include <qnamespace.h>
+#include <qsize.h>
 
 class QskTextColors;
 class QskTextOptions;
 
 class QString;
+class QStringList;
 class QFont;
 class QRectF;
-class QSizeF;
 class QQuickItem;
 class QSGTransformNode;
 
@@ -31,6 +32,14 @@ namespace QskTextRenderer
 
     QSK_EXPORT QSizeF textSize(
         const QString&, const QFont&, const QskTextOptions&, const QSizeF& );
+
+    /*
+        Measuring the sizes of texts in parallel, so that following
+        calls of textSize() find them in a cache. An invalid size
+        stands for the unconstrained sizes.
+     */
+    QSK_EXPORT void prepareTextSizes( const QStringList&,
+        const QFont&, const QskTextOptions&, const QSizeF& = QSizeF() );
 }
 
 #endif
@@ -0,0 +1,371 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#include "QskTextureCache.h"
+
+#include <qhash.h>
+#include <qmutex.h>
+#include <qquickwindow.h>
+#include <qsgtexture.h>
+
+#include <list>
+#include <unordered_map>
+
+namespace
+{
+    class Key
+    {
+      public:
+        inline bool operator==( const Key& other ) const
+        {
+            return ( hash == other.hash ) && ( size == other.size );
+        }
+
+        QskHashValue hash;
+        QSize size;
+    };
+
+    class KeyHash
+    {
+      public:
+        inline size_t operator()( const Key& key ) const
+        {
+            return qHash( key.size.width(),
+                qHash( key.size.height(), key.hash ) );
+        }
+    };
+
+    class Entry;
+    using EntryList = std::list< Entry* >;
+
+    class Entry
+    {
+      public:
+        Key key;
+        QSGTexture* texture = nullptr;
+
+        qint64 bytes = 0;
+        int refCount = 0;
+
+        // position in the list of unused textures
+        EntryList::iterator unusedPos;
+    };
+
+    class CacheMap
+    {
+      public:
+        inline QskTextureCache* cache( const QQuickWindow* window ) const
+        {
+            return m_hash.value( window, nullptr );
+        }
+
+        inline void insert( const QQuickWindow* window, QskTextureCache* cache )
+        {
+            m_hash.insert( window, cache );
+        }
+
+        inline QskTextureCache* take( const QQuickWindow* window )
+        {
+            return m_hash.take( window );
+        }
+
+        inline QList< QskTextureCache* > caches() const
+        {
+            return m_hash.values();
+        }
+
+        QMutex mutex;
+
+      private:
+        QHash< const QQuickWindow*, QskTextureCache* > m_hash;
+    };
+}
+
+Q_GLOBAL_STATIC( CacheMap, qskCacheMap )
+
+/*
+    The caches are used from the scene graph threads, while the windows
+    are destroyed in the GUI thread. As all operations are cheap we simply
+    serialize them with one mutex.
+ */
+#define QSK_CACHE_LOCKER QMutexLocker locker( &qskCacheMap->mutex )
+
+class QskTextureCache::PrivateData
+{
+  public:
+    ~PrivateData()
+    {
+        for ( auto& it : entries )
+            delete it.second.texture;
+    }
+
+    std::unordered_map< Key, Entry, KeyHash > entries;
+    std::unordered_map< const QSGTexture*, Entry* > textureMap;
+
+    // unused textures, the most recently used one in front
+    EntryList unusedEntries;
+
+    qint64 maxBytes = 16 * 1024 * 1024;
+    Statistics statistics;
+};
+
+QskTextureCache::QskTextureCache( QQuickWindow* window )
+    : m_data( new PrivateData() )
+{
+    /*
+        Deleting textures has to be done with the scene graph
+        context being current, so we clear the cache, before the
+        scene graph gets invalidated.
+     */
+    QObject::connect( window, &QQuickWindow::sceneGraphInvalidated,
+        [ this ] { clear(); } );
+
+    QObject::connect( window, &QObject::destroyed,
+        [ window ]
+        {
+            QskTextureCache* cache = nullptr;
+
+            if ( qskCacheMap )
+            {
+                QSK_CACHE_LOCKER;
+                cache = qskCacheMap->take( window );
+            }
+
+            delete cache;
+        } );
+}
+
+QskTextureCache::~QskTextureCache()
+{
+}
+
+QskTextureCache* QskTextureCache::instance( QQuickWindow* window )
+{
+    if ( window == nullptr || !qskCacheMap )
+        return nullptr;
+
+    QSK_CACHE_LOCKER;
+
+    auto cache = qskCacheMap->cache( window );
+    if ( cache == nullptr )
+    {
+        cache = new QskTextureCache( window );
+        qskCacheMap->insert( window, cache );
+    }
+
+    return cache;
+}
+
+void QskTextureCache::setMaxBytes( qint64 maxBytes )
+{
+    QSK_CACHE_LOCKER;
+
+    m_data->maxBytes = qMax( maxBytes, qint64( 0 ) );
+    evict();
+}
+
+qint64 QskTextureCache::maxBytes() const
+{
+    return m_data->maxBytes;
+}
+
+QSGTexture* QskTextureCache::acquire( QskHashValue hash, const QSize& size )
+{
+    QSK_CACHE_LOCKER;
+
+    auto& statistics = m_data->statistics;
+
+    auto it = m_data->entries.find( { hash, size } );
+    if ( it == m_data->entries.end() )
+    {
+        statistics.misses++;
+        return nullptr;
+    }
+
+    statistics.hits++;
+
+    auto& entry = it->second;
+    if ( entry.refCount++ == 0 )
+    {
+        m_data->unusedEntries.erase( entry.unusedPos );
+        statistics.unused--;
+    }
+
+    return entry.texture;
+}
+
+QSGTexture* QskTextureCache::insert(
+    QskHashValue hash, const QSize& size, QSGTexture* texture )
+{
+    if ( texture == nullptr )
+        return nullptr;
+
+    QSK_CACHE_LOCKER;
+
+    const Key key { hash, size };
+
+    auto it = m_data->entries.find( key );
+    if ( it != m_data->entries.end() )
+    {
+        /*
+            Should not happen as the texture has been created
+            because of a failing acquire(). But if it does we replace
+            the existing texture, when it is not in use.
+         */
+        auto& entry = it->second;
+
+        if ( entry.refCount > 0 )
+        {
+            delete texture;
+            entry.refCount++;
+
+            return entry.texture;
+        }
+
+        m_data->unusedEntries.erase( entry.unusedPos );
+        m_data->statistics.unused--;
+        m_data->statistics.bytes -= entry.bytes;
+        m_data->statistics.count--;
+
+        m_data->textureMap.erase( entry.texture );
+        delete entry.texture;
+
+        m_data->entries.erase( it );
+    }
+
+    auto& entry = m_data->entries[ key ];
+
+    entry.key = key;
+    entry.texture = texture;
+    entry.bytes = qint64( size.width() ) * size.height() * 4;
+    entry.refCount = 1;
+
+    m_data->textureMap[ texture ] = &entry;
+
+    m_data->statistics.count++;
+    m_data->statistics.bytes += entry.bytes;
+
+    evict();
+
+    return texture;
+}
+
+void QskTextureCache::release( const QSGTexture* texture )
+{
+    if ( texture == nullptr || !qskCacheMap )
+        return;
+
+    QSK_CACHE_LOCKER;
+
+    const auto caches = qskCacheMap->caches();
+    for ( auto cache : caches )
+    {
+        if ( cache->releaseTexture( texture ) )
+            break;
+    }
+}
+
+bool QskTextureCache::releaseTexture( const QSGTexture* texture )
+{
+    auto it = m_data->textureMap.find( texture );
+    if ( it == m_data->textureMap.end() )
+        return false;
+
+    auto entry = it->second;
+
+    if ( entry->refCount > 0 && --entry->refCount == 0 )
+    {
+        m_data->unusedEntries.push_front( entry );
+        entry->unusedPos = m_data->unusedEntries.begin();
+
+        m_data->statistics.unused++;
+
+        evict();
+    }
+
+    return true;
+}
+
+void QskTextureCache::evict()
+{
+    auto& statistics = m_data->statistics;
+
+    while ( statistics.bytes > m_data->maxBytes
+        && !m_data->unusedEntries.empty() )
+    {
+        auto entry = m_data->unusedEntries.back();
+        m_data->unusedEntries.pop_back();
+
+        statistics.unused--;
+        statistics.count--;
+        statistics.bytes -= entry->bytes;
+        statistics.evictions++;
+
+        m_data->textureMap.erase( entry->texture );
+        delete entry->texture;
+
+        const auto key = entry->key;
+        m_data->entries.erase( key );
+    }
+}
+
+void QskTextureCache::clear()
+{
+    QSK_CACHE_LOCKER;
+
+    /*
+        Textures, that are still referenced, are deleted as well. This is
+        only done, when the scene graph is going away and the nodes, that
+        hold the references, are not rendered anymore.
+     */
+    for ( auto& it : m_data->entries )
+        delete it.second.texture;
+
+    m_data->entries.clear();
+    m_data->textureMap.clear();
+    m_data->unusedEntries.clear();
+
+    auto& statistics = m_data->statistics;
+
+    statistics.count = statistics.unused = 0;
+    statistics.bytes = 0;
+}
+
+QskTextureCache::Statistics QskTextureCache::statistics() const
+{
+    QSK_CACHE_LOCKER;
+    return m_data->statistics;
+}
+
+void QskTextureCache::resetStatistics()
+{
+    QSK_CACHE_LOCKER;
+
+    auto& statistics = m_data->statistics;
+    statistics.hits = statistics.misses = statistics.evictions = 0;
+}
+
+#ifndef QT_NO_DEBUG_STREAM
+
+#include <qdebug.h>
+
+QDebug operator<<( QDebug debug, const QskTextureCache::Statistics& statistics )
+{
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    debug << "QskTextureCache" << '(';
+    debug << "textures: " << statistics.count
+          << ", unused: " << statistics.unused
+          << ", bytes: " << statistics.bytes
+          << ", hits: " << statistics.hits
+          << ", misses: " << statistics.misses
+          << ", evictions: " << statistics.evictions;
+    debug << ')';
+
+    return debug;
+}
+
+#endif
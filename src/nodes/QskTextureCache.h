@@ -0,0 +1,83 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) 2016 Uwe Rathmann
+ * This file may be used under the terms of the QSkinny License, Version 1.0
+ *****************************************************************************/
+
+#ifndef QSK_TEXTURE_CACHE_H
+#define QSK_TEXTURE_CACHE_H
+
+#include "QskGlobal.h"
+#include <memory>
+
+class QQuickWindow;
+class QSGTexture;
+class QSize;
+
+/*
+    QskTextureCache allows to share textures between nodes, that
+    display the same content - f.e the icons of a list of buttons.
+    Textures are identified by a hash value of the content and
+    the size in pixels.
+
+    The textures are reference counted. Textures, that are not in use
+    anymore, are kept until the byte budget of the cache is exceeded.
+    Then the least recently used ones are deleted first.
+
+    The cache is bound to a window and has to be used from
+    the scene graph thread only.
+ */
+class QSK_EXPORT QskTextureCache
+{
+  public:
+    class Statistics
+    {
+      public:
+        int count = 0;
+        int unused = 0;
+        qint64 bytes = 0;
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+    };
+
+    static QskTextureCache* instance( QQuickWindow* );
+
+    void setMaxBytes( qint64 );
+    qint64 maxBytes() const;
+
+    // returns a referenced texture or nullptr
+    QSGTexture* acquire( QskHashValue, const QSize& );
+
+    // takes ownership and returns the texture with a reference
+    QSGTexture* insert( QskHashValue, const QSize&, QSGTexture* );
+
+    // drops a reference of a texture, that has been acquired from any cache
+    static void release( const QSGTexture* );
+
+    void clear();
+
+    Statistics statistics() const;
+    void resetStatistics();
+
+  private:
+    QskTextureCache( QQuickWindow* );
+    ~QskTextureCache();
+
+    Q_DISABLE_COPY( QskTextureCache )
+
+    bool releaseTexture( const QSGTexture* );
+    void evict();
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#ifndef QT_NO_DEBUG_STREAM
+
+class QDebug;
+QSK_EXPORT QDebug operator<<( QDebug, const QskTextureCache::Statistics& );
+
+#endif
+
+#endif
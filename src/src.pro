@@ -77,6 +77,7 @@ HEADERS += \
     graphic/QskGraphic.h \
     graphic/QskGraphicImageProvider.h \
     graphic/QskGraphicIO.h \
+    graphic/QskGraphicMapping.h \
     graphic/QskGraphicPaintEngine.h \
     graphic/QskGraphicProvider.h \
     graphic/QskGraphicProviderMap.h \
@@ -89,6 +90,7 @@ SOURCES += \
     graphic/QskGraphic.cpp \
     graphic/QskGraphicImageProvider.cpp \
     graphic/QskGraphicIO.cpp \
+    graphic/QskGraphicMapping.cpp \
     graphic/QskGraphicPaintEngine.cpp \
     graphic/QskGraphicProvider.cpp \
     graphic/QskGraphicProviderMap.cpp \
@@ -111,7 +113,9 @@ HEADERS += \
     nodes/QskScaleRenderer.h \
     nodes/QskSGNode.h \
     nodes/QskShadedBoxNode.h \
+    nodes/QskTextLayoutCache.h \
     nodes/QskTextNode.h \
+    nodes/QskTextureCache.h \
     nodes/QskTextRenderer.h \
     nodes/QskTextureRenderer.h \
     nodes/QskTickmarksNode.h \
@@ -133,7 +137,9 @@ SOURCES += \
     nodes/QskScaleRenderer.cpp \
     nodes/QskSGNode.cpp \
     nodes/QskShadedBoxNode.cpp \
+    nodes/QskTextLayoutCache.cpp \
     nodes/QskTextNode.cpp \
+    nodes/QskTextureCache.cpp \
     nodes/QskTextRenderer.cpp \
     nodes/QskTextureRenderer.cpp \
     nodes/QskTickmarksNode.cpp \
@@ -161,6 +167,7 @@ HEADERS += \
     controls/QskFlickAnimator.h \
     controls/QskFocusIndicator.h \
     controls/QskFocusIndicatorSkinlet.h \
+    controls/QskFrameStatistics.h \
     controls/QskGesture.h \
     controls/QskGestureRecognizer.h \
     controls/QskGraphicLabel.h \
@@ -197,6 +204,7 @@ HEADERS += \
     controls/QskSimpleListBox.h \
     controls/QskSkin.h \
     controls/QskSkinFactory.h \
+    controls/QskSkinHintCache.h \
     controls/QskSkinHintTable.h \
     controls/QskSkinHintTableEditor.h \
     controls/QskSkinManager.h \
@@ -208,6 +216,7 @@ HEADERS += \
     controls/QskSliderSkinlet.h \
     controls/QskStatusIndicator.h \
     controls/QskStatusIndicatorSkinlet.h \
+    controls/QskSubcontrolIndex.h \
     controls/QskSubWindowArea.h \
     controls/QskSubWindowAreaSkinlet.h \
     controls/QskSubWindow.h \
@@ -245,6 +254,7 @@ SOURCES += \
     controls/QskFlickAnimator.cpp \
     controls/QskFocusIndicator.cpp \
     controls/QskFocusIndicatorSkinlet.cpp \
+    controls/QskFrameStatistics.cpp \
     controls/QskGesture.cpp \
     controls/QskGestureRecognizer.cpp \
     controls/QskGraphicLabel.cpp \
@@ -280,6 +290,7 @@ SOURCES += \
     controls/QskShortcutMap.cpp \
     controls/QskSimpleListBox.cpp \
     controls/QskSkin.cpp \
+    controls/QskSkinHintCache.cpp \
     controls/QskSkinHintTable.cpp \
     controls/QskSkinHintTableEditor.cpp \
     controls/QskSkinFactory.cpp \
@@ -291,6 +302,7 @@ SOURCES += \
     controls/QskSliderSkinlet.cpp \
     controls/QskStatusIndicator.cpp \
     controls/QskStatusIndicatorSkinlet.cpp \
+    controls/QskSubcontrolIndex.cpp \
     controls/QskSubWindowArea.cpp \
     controls/QskSubWindowAreaSkinlet.cpp \
     controls/QskSubWindow.cpp \
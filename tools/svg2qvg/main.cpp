@@ -10,9 +10,11 @@
 #include <QskPainterCommand.cpp>
 #include <QskGraphicPaintEngine.cpp>
 #include <QskGraphicIO.cpp>
+#include <QskGraphicMapping.cpp>
 #else
 #include <QskGraphicIO.h>
 #include <QskGraphic.h>
+#include <QskPainterCommand.h>
 #endif
 
 #include <QGuiApplication>
@@ -20,14 +22,527 @@
 #include <QPainter>
 #include <QDebug>
 
+#include <QCryptographicHash>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QSet>
+#include <QTextStream>
+#include <QRunnable>
+#include <QThreadPool>
+#include <QVector>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qguiapplication_p.h>
+#include <qpa/qplatformintegration.h>
+QSK_QT_PRIVATE_END
+
 static void usage( const char* appName )
 {
-    qWarning() << "usage: " << appName << "svgfile qvgfile";
+    qWarning() << "usage: " << appName << "[--mapped] svgfile qvgfile";
+    qWarning() << "       " << appName << "[--mapped] [--force] [--jobs count]"
+        << "[--output dir] [--manifest file] [--cache file] [--report file]"
+        << "[svgfile|dir ...]";
+    qWarning() << "manifest: one \"svgfile[<TAB>qvgfile]\" per line,"
+        << "lines starting with '#' are ignored";
+}
+
+namespace
+{
+    class Options
+    {
+      public:
+        bool mapped = false;
+        bool force = false;
+        int jobs = 0;
+
+        QString outputDir;
+        QString cacheFile;
+        QString reportFile;
+        QStringList manifests;
+
+        QStringList inputs;
+    };
+
+    class Job
+    {
+      public:
+        enum Status
+        {
+            Failed,
+            Converted,
+            Unchanged
+        };
+
+        QString svgFile;
+        QString qvgFile;
+
+        Status status = Failed;
+
+        // content hash of the svg file and the output format
+        QByteArray hash;
+
+        qint64 time = 0; // microseconds
+
+        int commandCount = 0;
+        int pathCount = 0;
+    };
+}
+
+static bool qskConvert( QSvgRenderer& renderer,
+    const QString& svgFile, const QString& qvgFile, bool mapped, Job* job = nullptr )
+{
+    QskGraphic graphic;
+
+    QPainter painter( &graphic );
+    renderer.render( &painter );
+    painter.end();
+
+    if ( graphic.commandTypes() & QskGraphic::RasterData )
+        qWarning() << svgFile << "contains non scalable parts.";
+
+    if ( job )
+    {
+        const auto& commands = graphic.commands();
+
+        job->commandCount = commands.count();
+
+        for ( const auto& command : commands )
+        {
+            if ( command.type() == QskPainterCommand::Path )
+                job->pathCount++;
+        }
+    }
+
+    const auto format = mapped ? QskGraphicIO::Mapped : QskGraphicIO::Stream;
+    return QskGraphicIO::write( graphic, qvgFile, format );
+}
+
+static QByteArray qskHash( const QByteArray& svgData, bool mapped )
+{
+    QCryptographicHash hash( QCryptographicHash::Sha1 );
+    hash.addData( svgData );
+
+    // a different format needs to be converted again
+    hash.addData( mapped ? "mapped" : "stream" );
+
+    return hash.result().toHex();
+}
+
+static void qskRunJob( Job& job, const QHash< QString, QByteArray >& cache,
+    const Options& options )
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file( job.svgFile );
+    if ( file.open( QIODevice::ReadOnly ) )
+    {
+        const auto svgData = file.readAll();
+        job.hash = qskHash( svgData, options.mapped );
+
+        if ( !options.force && cache.value( job.qvgFile ) == job.hash
+            && QFileInfo::exists( job.qvgFile ) )
+        {
+            job.status = Job::Unchanged;
+        }
+        else
+        {
+            QSvgRenderer renderer;
+            if ( renderer.load( svgData ) &&
+                qskConvert( renderer, job.svgFile, job.qvgFile, options.mapped, &job ) )
+            {
+                job.status = Job::Converted;
+            }
+        }
+    }
+
+    job.time = timer.nsecsElapsed() / 1000;
+}
+
+namespace
+{
+    class JobRunnable : public QRunnable
+    {
+      public:
+        JobRunnable( Job& job, const QHash< QString, QByteArray >& cache,
+                const Options& options )
+            : m_job( job )
+            , m_cache( cache )
+            , m_options( options )
+        {
+        }
+
+        void run() override
+        {
+            qskRunJob( m_job, m_cache, m_options );
+        }
+
+      private:
+        Job& m_job;
+        const QHash< QString, QByteArray >& m_cache;
+        const Options& m_options;
+    };
+}
+
+static bool qskIsThreaded()
+{
+    /*
+        QSvgRenderer renders texts, what is not thread safe
+        on platforms without ThreadedFontRendering
+     */
+    const auto platformIntegration = QGuiApplicationPrivate::platformIntegration();
+
+    return platformIntegration && platformIntegration->hasCapability(
+        QPlatformIntegration::ThreadedFontRendering );
+}
+
+static QHash< QString, QByteArray > qskReadCache( const QString& fileName )
+{
+    QHash< QString, QByteArray > cache;
+
+    QFile file( fileName );
+    if ( file.open( QIODevice::ReadOnly | QIODevice::Text ) )
+    {
+        // each line: hash, followed by the absolute path of the qvg file
+
+        while ( !file.atEnd() )
+        {
+            const auto line = file.readLine().trimmed();
+
+            const int pos = line.indexOf( ' ' );
+            if ( pos > 0 )
+                cache.insert( QString::fromUtf8( line.mid( pos + 1 ) ), line.left( pos ) );
+        }
+    }
+
+    return cache;
+}
+
+static bool qskWriteCache( const QString& fileName,
+    const QHash< QString, QByteArray >& cache )
+{
+    QFile file( fileName );
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text ) )
+        return false;
+
+    for ( auto it = cache.constBegin(); it != cache.constEnd(); ++it )
+        file.write( it.value() + ' ' + it.key().toUtf8() + '\n' );
+
+    return true;
+}
+
+static QString qskQvgFile( const QString& dir, const QString& relativeSvgPath )
+{
+    const QFileInfo fileInfo( relativeSvgPath );
+
+    auto path = fileInfo.path() + '/' + fileInfo.completeBaseName() + ".qvg";
+    return QFileInfo( QDir( dir ), path ).absoluteFilePath();
+}
+
+static void qskAddManifest( const QString& manifest,
+    const Options& options, QVector< Job >& jobs )
+{
+    /*
+        Each line of a manifest: svgfile[<TAB>qvgfile]
+
+        The paths are separated by a tab, so that they may contain spaces.
+        Relative paths are resolved against the directory of the manifest.
+        Without qvgfile the output is written to the output directory.
+        Empty lines and lines starting with '#' are ignored.
+     */
+
+    QFile file( manifest );
+    if ( !file.open( QIODevice::ReadOnly | QIODevice::Text ) )
+    {
+        qWarning() << "can't open" << manifest;
+        return;
+    }
+
+    const QDir dir = QFileInfo( manifest ).absoluteDir();
+
+    while ( !file.atEnd() )
+    {
+        const auto line = QString::fromUtf8( file.readLine() ).trimmed();
+        if ( line.isEmpty() || line.startsWith( '#' ) )
+            continue;
+
+        QString svgPath = line;
+        QString qvgPath;
+
+        const int pos = line.indexOf( '\t' );
+        if ( pos >= 0 )
+        {
+            svgPath = line.left( pos ).trimmed();
+            qvgPath = line.mid( pos + 1 ).trimmed();
+        }
+
+        if ( svgPath.isEmpty() )
+        {
+            qWarning() << manifest << ": missing svgfile in" << line;
+            continue;
+        }
+
+        Job job;
+        job.svgFile = QFileInfo( dir, svgPath ).absoluteFilePath();
+
+        if ( !qvgPath.isEmpty() )
+        {
+            job.qvgFile = QFileInfo( dir, qvgPath ).absoluteFilePath();
+        }
+        else
+        {
+            job.qvgFile = qskQvgFile( options.outputDir,
+                QFileInfo( svgPath ).fileName() );
+        }
+
+        jobs += job;
+    }
+}
+
+static QVector< Job > qskJobs( const Options& options )
+{
+    QVector< Job > jobs;
+
+    for ( const auto& manifest : options.manifests )
+        qskAddManifest( manifest, options, jobs );
+
+    for ( const auto& input : options.inputs )
+    {
+        const QFileInfo fileInfo( input );
+
+        if ( fileInfo.isDir() )
+        {
+            // the structure of the directory is mirrored in the output directory
+            const QDir dir( input );
+
+            QDirIterator it( input, { "*.svg" },
+                QDir::Files, QDirIterator::Subdirectories );
+
+            while ( it.hasNext() )
+            {
+                Job job;
+                job.svgFile = QFileInfo( it.next() ).absoluteFilePath();
+                job.qvgFile = qskQvgFile( options.outputDir,
+                    dir.relativeFilePath( job.svgFile ) );
+
+                jobs += job;
+            }
+        }
+        else
+        {
+            Job job;
+            job.svgFile = fileInfo.absoluteFilePath();
+            job.qvgFile = qskQvgFile( options.outputDir, fileInfo.fileName() );
+
+            jobs += job;
+        }
+    }
+
+    // the same output from different inputs would be written concurrently
+
+    QSet< QString > qvgFiles;
+
+    for ( int i = 0; i < jobs.count(); )
+    {
+        if ( qvgFiles.contains( jobs[i].qvgFile ) )
+        {
+            qWarning() << "ignoring" << jobs[i].svgFile << ":"
+                << jobs[i].qvgFile << "is already the output of another file";
+
+            jobs.remove( i );
+        }
+        else
+        {
+            qvgFiles += jobs[i].qvgFile;
+            i++;
+        }
+    }
+
+    return jobs;
+}
+
+static int qskConvertBatch( const Options& options )
+{
+    auto jobs = qskJobs( options );
+
+    for ( const auto& job : jobs )
+        QDir().mkpath( QFileInfo( job.qvgFile ).absolutePath() );
+
+    const auto cacheFile = options.cacheFile.isEmpty()
+        ? QDir( options.outputDir ).absoluteFilePath( ".svg2qvg-cache" )
+        : options.cacheFile;
+
+    auto cache = qskReadCache( cacheFile );
+
+    QElapsedTimer timer;
+    timer.start();
+
+    /*
+        The jobs are independent from each other: each of them
+        has its own QSvgRenderer and QskGraphic.
+     */
+    if ( qskIsThreaded() && ( options.jobs != 1 ) )
+    {
+        QThreadPool pool;
+        if ( options.jobs > 0 )
+            pool.setMaxThreadCount( options.jobs );
+
+        for ( auto& job : jobs )
+            pool.start( new JobRunnable( job, cache, options ) );
+
+        pool.waitForDone();
+    }
+    else
+    {
+        for ( auto& job : jobs )
+            qskRunJob( job, cache, options );
+    }
+
+    const auto elapsed = timer.elapsed();
+
+    QFile reportFile;
+
+    if ( options.reportFile.isEmpty() )
+        reportFile.open( stdout, QIODevice::WriteOnly | QIODevice::Text );
+    else
+        reportFile.setFileName( options.reportFile );
+
+    if ( !reportFile.isOpen() &&
+        !reportFile.open( QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text ) )
+    {
+        qWarning() << "can't open" << options.reportFile;
+    }
+
+    QTextStream report( &reportFile );
+    report << "status,time_us,commands,paths,svgfile,qvgfile\n";
+
+    const char* statusNames[] = { "failed", "converted", "unchanged" };
+
+    int counts[ 3 ] = { 0, 0, 0 };
+
+    for ( const auto& job : qAsConst( jobs ) )
+    {
+        counts[ job.status ]++;
+
+        report << statusNames[ job.status ] << ',' << job.time << ',';
+
+        if ( job.status == Job::Converted )
+            report << job.commandCount << ',' << job.pathCount << ',';
+        else
+            report << ",,";
+
+        report << job.svgFile << ',' << job.qvgFile << '\n';
+
+        if ( job.status == Job::Failed )
+        {
+            qWarning() << "can't convert" << job.svgFile;
+            cache.remove( job.qvgFile );
+        }
+        else
+        {
+            cache.insert( job.qvgFile, job.hash );
+        }
+    }
+
+    report.flush();
+
+    if ( !qskWriteCache( cacheFile, cache ) )
+        qWarning() << "can't write" << cacheFile;
+
+    QTextStream( stderr ) << "svg2qvg: " << counts[ Job::Converted ] << " converted, "
+        << counts[ Job::Unchanged ] << " unchanged, " << counts[ Job::Failed ]
+        << " failed in " << elapsed << "ms\n";
+
+    return counts[ Job::Failed ] ? -2 : 0;
 }
 
 int main( int argc, char* argv[] )
 {
-    if ( argc != 3 )
+    Options options;
+    bool isBatch = false;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        const QString arg = QString::fromLocal8Bit( argv[i] );
+
+        auto value = [&]( QString& to ) -> bool
+        {
+            if ( i + 1 >= argc )
+                return false;
+
+            to = QString::fromLocal8Bit( argv[++i] );
+            return true;
+        };
+
+        bool ok = true;
+
+        if ( arg == "--mapped" )
+        {
+            /*
+                writing the flat layout of QskGraphicMapping, that
+                is rendered from the memory of the file. As it is written in
+                the byte order of the host, it is not portable between platforms.
+             */
+            options.mapped = true;
+        }
+        else if ( arg == "--force" )
+        {
+            // converting all files, even if they have not changed
+            options.force = isBatch = true;
+        }
+        else if ( arg == "--jobs" )
+        {
+            QString count;
+            ok = value( count );
+            options.jobs = count.toInt();
+            isBatch = true;
+        }
+        else if ( arg == "--output" )
+        {
+            ok = value( options.outputDir );
+            isBatch = true;
+        }
+        else if ( arg == "--manifest" )
+        {
+            QString manifest;
+            ok = value( manifest );
+            options.manifests += manifest;
+            isBatch = true;
+        }
+        else if ( arg == "--cache" )
+        {
+            ok = value( options.cacheFile );
+            isBatch = true;
+        }
+        else if ( arg == "--report" )
+        {
+            ok = value( options.reportFile );
+            isBatch = true;
+        }
+        else if ( arg.startsWith( "--" ) )
+        {
+            ok = false;
+        }
+        else
+        {
+            options.inputs += arg;
+
+            if ( QFileInfo( arg ).isDir() )
+                isBatch = true;
+        }
+
+        if ( !ok )
+        {
+            usage( argv[0] );
+            return -1;
+        }
+    }
+
+    if ( !isBatch && options.inputs.count() != 2 )
     {
         usage( argv[0] );
         return -1;
@@ -51,21 +566,26 @@ int main( int argc, char* argv[] )
     QGuiApplication app( argc, argv );
 #endif
 
-    QSvgRenderer renderer;
-    if ( !renderer.load( QString( argv[1] ) ) )
-        return -2;
+    if ( isBatch )
+    {
+        /*
+            Converting many files in one process avoids the costs
+            of starting a process and initializing Qt for each of them.
+         */
+        if ( options.outputDir.isEmpty() )
+            options.outputDir = QDir::currentPath();
 
-    QskGraphic graphic;
+        return qskConvertBatch( options );
+    }
 
-    QPainter painter( &graphic );
-    renderer.render( &painter );
-    painter.end();
+    const auto& svgFile = options.inputs[0];
+    const auto& qvgFile = options.inputs[1];
 
-    if ( graphic.commandTypes() & QskGraphic::RasterData )
-        qWarning() << argv[1] << "contains non scalable parts.";
+    QSvgRenderer renderer;
+    if ( !renderer.load( svgFile ) )
+        return -2;
 
-    QskGraphicIO::write( graphic, argv[2] );
+    qskConvert( renderer, svgFile, qvgFile, options.mapped );
 
     return 0;
 }
-
@@ -3,6 +3,9 @@ TARGET = svg2qvg
 
 QT += svg
 
+# checking QPlatformIntegration::ThreadedFontRendering
+QT += gui-private
+
 CONFIG += standalone
 CONFIG -= app_bundle
 CONFIG -= sanitize
@@ -23,8 +26,6 @@ standalone {
 
     DEFINES += QSK_STANDALONE
     QSK_CONFIG -= QskDll
-
-    QT += gui-private
 }
 else {
 